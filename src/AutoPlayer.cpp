@@ -0,0 +1,95 @@
+#include "AutoPlayer.h"
+#include "GridRaycast.h"
+#include <cstdlib>  // Para abs()
+
+AutoPlayer::AutoPlayer(int player, PlayerStrategy strategy, std::uint64_t seed)
+    : player(player), strategy(strategy), rng(seed) {}
+
+// Buscar el enemigo más cercano
+// Qué sucede: Compara la distancia Manhattan a todos los tanques del otro jugador.
+const Tank* AutoPlayer::nearestEnemy(const GameState& state, const Tank& from) const {
+    const Tank* best = nullptr;
+    int bestDistance = 0;
+    for (const Tank& tank : state.getTanks()) {
+        if (GameState::belongsToPlayer(tank, player) || tank.isDestroyed()) {
+            continue;
+        }
+        int distance = std::abs(tank.getX() - from.getX()) + std::abs(tank.getY() - from.getY());
+        if (best == nullptr || distance < bestDistance) {
+            best = &tank;
+            bestDistance = distance;
+        }
+    }
+    return best;
+}
+
+// Decidir las entradas de este tick
+// Qué sucede: Sin tanque seleccionado, hace clic en uno de sus tanques al azar; después actúa según la estrategia.
+void AutoPlayer::think(const GameState& state, std::vector<GameInput>& inputs) {
+    if (state.isGameOver() || state.getCurrentPlayer() != player) {
+        return;
+    }
+
+    const Tank* selected = state.getSelectedTank();
+    if (selected == nullptr) {
+        std::vector<const Tank*> own;
+        for (const Tank& tank : state.getTanks()) {
+            if (GameState::belongsToPlayer(tank, player)) {
+                own.push_back(&tank);
+            }
+        }
+        if (!own.empty()) {
+            const Tank* choice = own[rng.below(static_cast<std::uint32_t>(own.size()))];
+            inputs.push_back({INPUT_CLICK, choice->getX(), choice->getY()});
+        }
+        return;
+    }
+
+    if (strategy == PLAYER_RANDOM) {
+        thinkRandom(state, inputs);
+    } else {
+        thinkScripted(state, *selected, inputs);
+    }
+}
+
+// Estrategia fija
+// Qué sucede:
+//   1. Sin poder usado: si hay línea de vista al enemigo más cercano activa el disparo (D); si no, el movimiento (M).
+//   2. En modo disparo: hace clic sobre el enemigo.
+//   3. Esperando destino: hace clic en una celda cerca del enemigo, prefiriendo las que `Map::isReachable` da como
+//      alcanzables desde el tanque (si no es válida, prueba otra el tick siguiente).
+void AutoPlayer::thinkScripted(const GameState& state, const Tank& selected, std::vector<GameInput>& inputs) {
+    const Tank* enemy = nearestEnemy(state, selected);
+    if (enemy == nullptr) {
+        return;
+    }
+
+    if (!state.isPowerUsed()) {
+        bool visible = isLineOfSightClear(selected.getX(), selected.getY(), enemy->getX(), enemy->getY(),
+                                          state.getMap());
+        inputs.push_back({visible ? INPUT_SHOOT : INPUT_MOVE});
+    } else if (state.isShootingMode() && !state.hasShotThisTurn()) {
+        inputs.push_back({INPUT_CLICK, enemy->getX(), enemy->getY()});
+    } else if (state.isWaitingForDestination()) {
+        int x = 0, y = 0;
+        for (int attempt = 0; attempt < 4; ++attempt) {
+            x = enemy->getX() + rng.range(-3, 3);
+            y = enemy->getY() + rng.range(-3, 3);
+            if (state.getMap().isReachable(selected.getX(), selected.getY(), x, y)) {
+                break;
+            }
+        }
+        inputs.push_back({INPUT_CLICK, x, y});
+    }
+}
+
+// Estrategia aleatoria
+// Qué sucede: Sin poder usado elige M o D; después hace clic en una celda cualquiera del mapa.
+void AutoPlayer::thinkRandom(const GameState& state, std::vector<GameInput>& inputs) {
+    if (!state.isPowerUsed()) {
+        inputs.push_back({rng.below(2) == 0 ? INPUT_MOVE : INPUT_SHOOT});
+    } else if ((state.isShootingMode() && !state.hasShotThisTurn()) || state.isWaitingForDestination()) {
+        int size = state.getMap().getSize();
+        inputs.push_back({INPUT_CLICK, rng.range(0, size - 1), rng.range(0, size - 1)});
+    }
+}
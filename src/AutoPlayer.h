@@ -0,0 +1,42 @@
+#ifndef AUTO_PLAYER_H
+#define AUTO_PLAYER_H
+
+#include "GameState.h"
+#include "Rng.h"
+#include <vector>
+
+// Estrategias de los jugadores automáticos
+enum PlayerStrategy {
+    PLAYER_SCRIPTED,  // Dispara al enemigo más cercano si lo ve; si no, se acerca a él
+    PLAYER_RANDOM  // Elige teclas y celdas al azar
+};
+
+// Jugador automático simple
+// Qué sucede: En cada tick de su turno genera las mismas entradas que un humano (clics en celdas y teclas M y D)
+//             según su estrategia, con un generador aleatorio propio.
+// Por qué sucede: El modo sin ventana necesita alguien que juegue para correr partidas completas.
+// Qué deberíamos esperar: Una política básica de referencia, no una IA competitiva.
+class AutoPlayer {
+public:
+    // Constructor
+    // Qué sucede: `player` es el jugador que controla (1 o 2); `seed` inicializa su generador aleatorio.
+    AutoPlayer(int player, PlayerStrategy strategy = PLAYER_SCRIPTED, std::uint64_t seed = 0);
+
+    // Decidir las entradas de este tick
+    // Qué sucede: Agrega a `inputs` las acciones del jugador si es su turno; si no, no agrega nada.
+    void think(const GameState& state, std::vector<GameInput>& inputs);
+
+    int getPlayer() const { return player; }
+
+private:
+    int player;  // Jugador controlado (1 o 2)
+    PlayerStrategy strategy;
+    Rng rng;  // Generador propio, para que cada partida sea independiente de las demás
+
+    void thinkScripted(const GameState& state, const Tank& selected, std::vector<GameInput>& inputs);
+    void thinkRandom(const GameState& state, std::vector<GameInput>& inputs);
+
+    const Tank* nearestEnemy(const GameState& state, const Tank& from) const;
+};
+
+#endif
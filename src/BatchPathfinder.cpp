@@ -0,0 +1,31 @@
+#include "BatchPathfinder.h"
+
+// Consultas por bloque: pocas para que el robo de trabajo equilibre búsquedas de costo muy distinto
+static const int kRequestsPerTask = 4;
+
+// Constructor
+// Qué sucede: Los espacios de trabajo se dimensionan en la primera búsqueda de cada hilo.
+BatchPathfinder::BatchPathfinder(int threadCount) : pool(threadCount), workspaces(pool.getThreadCount()) {}
+
+// Resolver un lote de consultas
+// Qué sucede: Cada bloque escribe en sus propias posiciones del vector de resultados, así no hace falta sincronizar.
+// Qué deberíamos esperar: `result[i]` es la ruta de `requests[i]` (vacía si no hay ruta o el destino no es válido).
+std::vector<std::vector<Cell>> BatchPathfinder::solve(const Map& map, const OccupancyGrid& occupancy,
+                                                      const std::vector<PathRequest>& requests) {
+    std::vector<std::vector<Cell>> result(requests.size());
+
+    pool.parallelFor(static_cast<int>(requests.size()), kRequestsPerTask, [&](int begin, int end, int worker) {
+        SearchWorkspace& workspace = workspaces[worker];
+        for (int i = begin; i < end; ++i) {
+            const PathRequest& request = requests[i];
+            if (!map.isValidPosition(request.startX, request.startY) ||
+                !map.isValidPosition(request.goalX, request.goalY)) {
+                continue;
+            }
+            result[i] = findPath(request.algorithm, map, request.startX, request.startY,
+                                 request.goalX, request.goalY, occupancy, workspace);
+        }
+    });
+
+    return result;
+}
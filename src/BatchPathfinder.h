@@ -0,0 +1,45 @@
+#ifndef BATCH_PATHFINDER_H
+#define BATCH_PATHFINDER_H
+
+#include "Map.h"
+#include "OccupancyGrid.h"
+#include "Pathfinding.h"
+#include "SearchWorkspace.h"
+#include "ThreadPool.h"
+#include <vector>
+
+// Consulta de ruta de un lote
+// Qué sucede: Identifica el tanque, su posición actual, el destino y el algoritmo a usar.
+struct PathRequest {
+    int tankId;
+    int startX, startY;
+    int goalX, goalY;
+    PathAlgorithm algorithm;
+};
+
+// Búsqueda de rutas por lotes en todos los núcleos
+// Qué sucede: Resuelve N consultas en paralelo sobre un pool con robo de trabajo; cada hilo usa su propio
+//             `SearchWorkspace`, así que las búsquedas no comparten estado mutable.
+// Por qué sucede: Planificar los movimientos de cientos de tanques de IA por turno, de a una consulta en el hilo
+//                 de dibujo, congelaba el juego.
+// Qué deberíamos esperar: Las rutas en el mismo orden que las consultas. El mapa y la ocupación se tratan como una
+//                         instantánea de solo lectura: no deben modificarse mientras `solve` se ejecuta.
+class BatchPathfinder {
+public:
+    // Constructor
+    // Qué sucede: Crea el pool con `threadCount` hilos (0 = todos los núcleos) y un espacio de trabajo por hilo.
+    explicit BatchPathfinder(int threadCount = 0);
+
+    // Resolver un lote
+    // Qué sucede: Reparte las consultas en bloques pequeños y espera a que terminen todas.
+    std::vector<std::vector<Cell>> solve(const Map& map, const OccupancyGrid& occupancy,
+                                         const std::vector<PathRequest>& requests);
+
+    int getThreadCount() const { return pool.getThreadCount(); }
+
+private:
+    ThreadPool pool;  // Hilos trabajadores
+    std::vector<SearchWorkspace> workspaces;  // Un espacio de trabajo por hilo
+};
+
+#endif
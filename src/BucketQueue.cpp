@@ -0,0 +1,22 @@
+#include "BucketQueue.h"
+
+BucketQueue::BucketQueue() : mask(0), current(-1), count(0) {}
+
+// Vaciar la cola
+// Qué sucede: Usa la menor potencia de 2 mayor que `span`, así que una prioridad pendiente nunca comparte cubeta con
+//             otra distinta.
+void BucketQueue::reset(int span) {
+    std::size_t needed = 1;
+    while (needed <= static_cast<std::size_t>(span)) {
+        needed *= 2;
+    }
+    if (buckets.size() < needed) {
+        buckets.resize(needed);
+    }
+    for (std::vector<int>& bucket : buckets) {
+        bucket.clear();
+    }
+    mask = static_cast<int>(needed) - 1;
+    current = -1;
+    count = 0;
+}
@@ -0,0 +1,54 @@
+#ifndef BUCKET_QUEUE_H
+#define BUCKET_QUEUE_H
+
+#include <vector>
+#include <cstddef>
+
+// Cola de prioridad monótona por cubetas (algoritmo de Dial)
+// Qué sucede: Hay una cubeta por prioridad en un arreglo circular de potencia de 2. `pop` avanza hasta la primera
+//             cubeta no vacía y saca su último valor; `push` agrega al final de la cubeta de su prioridad.
+// Por qué sucede: Con costos enteros chicos, Dijkstra y A* nunca insertan una prioridad más baja que la última que
+//                 sacaron ni más alta que ella más el mayor costo de un paso. Así cada operación es O(1), sin las
+//                 comparaciones y los saltos de memoria de un heap binario.
+// Qué deberíamos esperar: Solo sirve si se respeta la monotonía: cada prioridad insertada está entre la última sacada
+//                         y esa más `span`, y las prioridades no son negativas. Con la misma prioridad sale primero
+//                         el último insertado.
+class BucketQueue {
+public:
+    BucketQueue();
+
+    // Vaciar la cola para una búsqueda cuyas prioridades superan a la última sacada en a lo sumo `span`.
+    // Qué deberíamos esperar: Las cubetas conservan su capacidad entre búsquedas.
+    void reset(int span);
+
+    bool empty() const { return count == 0; }
+
+    void push(int priority, int value) {
+        if (current < 0) {
+            current = priority;  // Primera inserción desde `reset`: la búsqueda empieza en esta prioridad
+        }
+        buckets[priority & mask].push_back(value);
+        ++count;
+    }
+
+    // Sacar un valor de la menor prioridad pendiente y devolver esa prioridad en `priority`.
+    int pop(int& priority) {
+        while (buckets[current & mask].empty()) {
+            ++current;
+        }
+        std::vector<int>& bucket = buckets[current & mask];
+        int value = bucket.back();
+        bucket.pop_back();
+        --count;
+        priority = current;
+        return value;
+    }
+
+private:
+    std::vector<std::vector<int>> buckets;  // Valores pendientes de cada prioridad, indexados por `prioridad & mask`
+    int mask;  // Cantidad de cubetas menos 1
+    int current;  // Menor prioridad que puede tener un valor pendiente (-1 antes de la primera inserción)
+    std::size_t count;  // Valores pendientes en total
+};
+
+#endif
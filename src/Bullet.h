@@ -1,11 +1,16 @@
 #ifndef BULLET_H
 #define BULLET_H
 
-#include <SFML/Graphics.hpp>
 #include "Map.h"
 #include "Tank.h"
+#include "GridRaycast.h"
 #include <vector>
 
+// Aplicar el daño de una bala a un tanque
+// Qué sucede: Los tanques azul/celeste reciben 25 de daño y los rojo/amarillo 50.
+// Por qué sucede: La regla se comparte entre `Bullet` y `BulletSystem`.
+void applyBulletDamage(Tank& tank);
+
 // Clase Bullet para representar la bala disparada por un tanque
 class Bullet {
 public:
@@ -19,13 +24,14 @@ public:
     // Qué sucede: Actualiza la posición de la bala según su dirección y velocidad, y verifica colisiones con tanques y obstáculos.
     // Por qué sucede: La bala debe moverse en cada frame y destruirse si colisiona con un obstáculo o tanque.
     // Qué deberíamos esperar: La bala se mueve hacia adelante, y `destroyBullet` se establece en true si debe ser eliminada.
-    void update(const Map& map, std::vector<Tank>& tanks, bool& destroyBullet);
-
-    // Método para dibujar la bala
-    // Qué sucede: Dibuja la bala en su posición actual sobre la ventana.
-    // Por qué sucede: La bala debe ser visible para los jugadores mientras se mueve.
-    // Qué deberíamos esperar: La bala se dibuja en la ventana en su posición actual.
-    void draw(sf::RenderWindow& window, int cellSize);
+    //                         El desplazamiento completo se recorre con `castRay`, así que no atraviesa esquinas; en
+    //                         obstáculos y bordes la bala se refleja según la cara impactada.
+    void update(const Map& map, const OccupancyGrid& occupancy, std::vector<Tank>& tanks, bool& destroyBullet);
+
+    // Posición actual de la bala (en celdas)
+    // Qué sucede: Permite que el renderizador la dibuje sin que la bala dependa de SFML.
+    float getX() const { return posX; }
+    float getY() const { return posY; }
 
 private:
     float posX, posY;  // Posición de la bala
@@ -0,0 +1,166 @@
+#include "BulletSystem.h"
+#include "Bullet.h"
+#include <cmath>
+#include <utility>
+
+// Constructor
+// Qué sucede: Reserva los arreglos para `capacity` balas sin crear ninguna.
+BulletSystem::BulletSystem(std::size_t capacity) : activeCount(0) {
+    posX.reserve(capacity);
+    posY.reserve(capacity);
+    previousX.reserve(capacity);
+    previousY.reserve(capacity);
+    dirX.reserve(capacity);
+    dirY.reserve(capacity);
+    speed.reserve(capacity);
+    shooterId.reserve(capacity);
+    alive.reserve(capacity);
+}
+
+// Disparar una bala
+// Qué sucede: Calcula la dirección normalizada hacia el objetivo y ocupa un hueco de la lista libre, o agrega uno.
+// Por qué sucede: Reutilizar huecos mantiene los arreglos compactos sin reservar memoria en cada disparo.
+int BulletSystem::spawn(int startX, int startY, int targetX, int targetY, int shooter, float bulletSpeed) {
+    float dx = static_cast<float>(targetX - startX);
+    float dy = static_cast<float>(targetY - startY);
+    float length = std::sqrt(dx * dx + dy * dy);
+    if (length == 0.0f) {
+        return -1;
+    }
+
+    int slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        slot = static_cast<int>(posX.size());
+        posX.push_back(0);
+        posY.push_back(0);
+        previousX.push_back(0);
+        previousY.push_back(0);
+        dirX.push_back(0);
+        dirY.push_back(0);
+        speed.push_back(0);
+        shooterId.push_back(-1);
+        alive.push_back(0);
+    }
+
+    posX[slot] = static_cast<float>(startX);
+    posY[slot] = static_cast<float>(startY);
+    previousX[slot] = posX[slot];
+    previousY[slot] = posY[slot];
+    dirX[slot] = dx / length;
+    dirY[slot] = dy / length;
+    speed[slot] = bulletSpeed;
+    shooterId[slot] = shooter;
+    alive[slot] = 1;
+    ++activeCount;
+    return slot;
+}
+
+// Liberar el hueco de una bala
+// Qué sucede: Su velocidad pasa a 0 para que la pasada de integración no la mueva, y el hueco vuelve a la lista libre.
+void BulletSystem::release(int slot) {
+    alive[slot] = 0;
+    speed[slot] = 0.0f;
+    freeSlots.push_back(slot);
+    --activeCount;
+}
+
+// Buscar un tanque por su ID
+// Qué sucede: La primera vez que hay un impacto en esta actualización se arma la tabla ID -> índice.
+// Por qué sucede: Los impactos son poco frecuentes comparados con la cantidad de balas; no se paga nada sin impactos.
+Tank* BulletSystem::findTank(std::vector<Tank>& tanks, int id) {
+    if (tankIndexById.empty()) {
+        for (size_t i = 0; i < tanks.size(); ++i) {
+            int tankId = tanks[i].getId();
+            if (tankId >= static_cast<int>(tankIndexById.size())) {
+                tankIndexById.resize(tankId + 1, -1);
+            }
+            tankIndexById[tankId] = static_cast<int>(i);
+        }
+    }
+    if (id < 0 || id >= static_cast<int>(tankIndexById.size()) || tankIndexById[id] == -1) {
+        return nullptr;
+    }
+    return &tanks[tankIndexById[id]];
+}
+
+// Actualizar todas las balas
+// Qué sucede:
+//   1. Se arma una consulta de rayo por bala activa con todo su desplazamiento del frame (`dir * speed`).
+//   2. `castRays` resuelve el lote contra el terreno, el borde del mapa y los tanques (sin contar al tirador).
+//   3. Cada bala avanza hasta el punto de contacto. Si impactó a un tanque, le aplica el daño y se libera; si chocó
+//      con una pared, refleja su dirección y el resto del desplazamiento entra en la siguiente ronda.
+// Por qué sucede: Avanzar y mirar solo la celda final podía atravesar esquinas; con el rayo no se saltea ninguna celda.
+// Qué deberíamos esperar: Como máximo `MAX_RAY_BOUNCES` rondas; cada ronda solo contiene las balas que rebotaron.
+void BulletSystem::update(const Map& map, const OccupancyGrid& occupancy, std::vector<Tank>& tanks) {
+    previousX = posX;
+    previousY = posY;
+
+    queries.clear();
+    rayOwner.clear();
+    rayDistance.clear();
+    for (size_t i = 0; i < posX.size(); ++i) {
+        if (alive[i]) {
+            queries.push_back({posX[i], posY[i], dirX[i] * speed[i], dirY[i] * speed[i], shooterId[i]});
+            rayOwner.push_back(static_cast<int>(i));
+            rayDistance.push_back(speed[i]);
+        }
+    }
+
+    tankIndexById.clear();
+    for (int bounce = 0; bounce < MAX_RAY_BOUNCES && !queries.empty(); ++bounce) {
+        castRays(map, occupancy, queries, hits);
+
+        pendingQueries.clear();
+        pendingOwner.clear();
+        pendingDistance.clear();
+        for (size_t k = 0; k < queries.size(); ++k) {
+            const RayQuery& query = queries[k];
+            const RayHit& hit = hits[k];
+            int i = rayOwner[k];
+
+            contactPoint(hit, query.startX, query.startY, query.dx, query.dy, posX[i], posY[i]);
+            if (!hit.hit) {
+                continue;
+            }
+
+            if (hit.tankId != OccupancyGrid::EMPTY) {
+                Tank* tank = findTank(tanks, hit.tankId);
+                if (tank != nullptr) {
+                    applyBulletDamage(*tank);
+                }
+                release(i);
+                continue;
+            }
+
+            // Rebote en obstáculos y bordes del mapa
+            reflectDirection(hit, dirX[i], dirY[i]);
+            float remaining = rayDistance[k] * (1.0f - hit.fraction);
+            pendingQueries.push_back({posX[i], posY[i], dirX[i] * remaining, dirY[i] * remaining, shooterId[i]});
+            pendingOwner.push_back(i);
+            pendingDistance.push_back(remaining);
+        }
+
+        std::swap(queries, pendingQueries);
+        std::swap(rayOwner, pendingOwner);
+        std::swap(rayDistance, pendingDistance);
+    }
+}
+
+// Eliminar todas las balas
+// Qué sucede: Vacía los arreglos; la capacidad reservada se conserva.
+void BulletSystem::clear() {
+    posX.clear();
+    posY.clear();
+    previousX.clear();
+    previousY.clear();
+    dirX.clear();
+    dirY.clear();
+    speed.clear();
+    shooterId.clear();
+    alive.clear();
+    freeSlots.clear();
+    activeCount = 0;
+}
@@ -0,0 +1,71 @@
+#ifndef BULLET_SYSTEM_H
+#define BULLET_SYSTEM_H
+
+#include "Map.h"
+#include "OccupancyGrid.h"
+#include "Tank.h"
+#include "GridRaycast.h"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Sistema de balas en estructura de arreglos (SoA)
+// Qué sucede: Guarda posición, dirección, velocidad y tirador de todas las balas en arreglos contiguos, con una
+//             lista de huecos libres para reutilizar posiciones sin reservar memoria.
+// Por qué sucede: Con una sola `Bullet*` creada con `new` y un recorrido de todos los tanques por bala, no se podían
+//                 tener miles de proyectiles a la vez.
+// Qué deberíamos esperar: `update` lanza un rayo por bala en un solo lote (`castRays`) y resuelve los impactos y
+//                         rebotes a partir de la celda y la cara que devuelve cada rayo.
+class BulletSystem {
+public:
+    // Constructor
+    // Qué sucede: Reserva espacio para `capacity` balas; el sistema crece si se disparan más.
+    explicit BulletSystem(std::size_t capacity = 0);
+
+    // Disparar una bala
+    // Qué sucede: Ocupa un hueco libre (o uno nuevo) con la bala que va de `(startX, startY)` hacia el objetivo.
+    // Qué deberíamos esperar: El índice de la bala, o -1 si el objetivo coincide con el origen.
+    int spawn(int startX, int startY, int targetX, int targetY, int shooterId, float speed = 0.2f);
+
+    // Actualizar todas las balas
+    // Qué sucede: Avanza las balas, las refleja en obstáculos y bordes, y aplica el daño al tanque impactado.
+    void update(const Map& map, const OccupancyGrid& occupancy, std::vector<Tank>& tanks);
+
+    // Eliminar todas las balas.
+    void clear();
+
+    // Recorrer las balas para dibujarlas
+    // Qué sucede: `getSlotCount` incluye los huecos libres; `isActive` indica si un hueco tiene una bala.
+    //             `getPosition` interpola entre la posición del tick anterior y la actual según `alpha` (0 a 1).
+    std::size_t getSlotCount() const { return posX.size(); }
+    bool isActive(std::size_t slot) const { return alive[slot] != 0; }
+    void getPosition(std::size_t slot, float alpha, float& x, float& y) const {
+        x = previousX[slot] + (posX[slot] - previousX[slot]) * alpha;
+        y = previousY[slot] + (posY[slot] - previousY[slot]) * alpha;
+    }
+
+    std::size_t getActiveCount() const { return activeCount; }
+    bool empty() const { return activeCount == 0; }
+
+private:
+    std::vector<float> posX, posY;  // Posición de cada bala (en celdas)
+    std::vector<float> previousX, previousY;  // Posición al empezar el último tick (para interpolar el dibujo)
+    std::vector<float> dirX, dirY;  // Dirección normalizada
+    std::vector<float> speed;  // Celdas por actualización; 0 en los huecos libres
+    std::vector<int> shooterId;  // ID del tanque que disparó
+    std::vector<std::uint8_t> alive;  // 1 si la posición contiene una bala activa
+    std::vector<int> freeSlots;  // Huecos libres para reutilizar
+    std::vector<int> tankIndexById;  // Tabla ID -> índice en el vector de tanques, se arma solo si hay impactos
+    std::size_t activeCount;  // Cantidad de balas activas
+
+    // Buffers reutilizables del lote de rayos
+    std::vector<RayQuery> queries, pendingQueries;  // Rayos de esta ronda y de la siguiente (tras un rebote)
+    std::vector<int> rayOwner, pendingOwner;  // Bala a la que pertenece cada rayo
+    std::vector<float> rayDistance, pendingDistance;  // Distancia que le queda a cada bala en esta actualización
+    std::vector<RayHit> hits;
+
+    void release(int slot);
+    Tank* findTank(std::vector<Tank>& tanks, int id);
+};
+
+#endif
@@ -0,0 +1,48 @@
+#include "ChangeJournal.h"
+#include <atomic>
+
+// Constructor
+// Qué sucede: Reserva el búfer circular; sin historial, cualquier versión es válida como punto de partida.
+ChangeJournal::ChangeJournal(std::size_t capacity)
+    : ring(capacity == 0 ? 1 : capacity), next(0), count(0), floor(0) {}
+
+// Anotar un cambio
+// Qué sucede: Si el búfer está lleno, el cambio más antiguo se pierde y el piso sube hasta su versión.
+void ChangeJournal::record(std::uint64_t version, int cell) {
+    if (count == ring.size()) {
+        floor = ring[next].version;
+    } else {
+        ++count;
+    }
+    ring[next] = {version, cell};
+    next = (next + 1) % ring.size();
+}
+
+// Olvidar el historial
+void ChangeJournal::reset(std::uint64_t version) {
+    next = 0;
+    count = 0;
+    floor = version;
+}
+
+// Celdas cambiadas desde una versión
+// Qué sucede: Recorre los cambios retenidos y agrega los posteriores a `version`.
+bool ChangeJournal::changesSince(std::uint64_t version, std::vector<int>& cells) const {
+    if (version < floor) {
+        return false;
+    }
+    std::size_t start = (next + ring.size() - count) % ring.size();
+    for (std::size_t i = 0; i < count; ++i) {
+        const Change& change = ring[(start + i) % ring.size()];
+        if (change.version > version) {
+            cells.push_back(change.cell);
+        }
+    }
+    return true;
+}
+
+// Sello de versión global
+std::uint64_t ChangeJournal::newVersion() {
+    static std::atomic<std::uint64_t> counter(0);
+    return ++counter;
+}
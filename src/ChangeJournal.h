@@ -0,0 +1,47 @@
+#ifndef CHANGE_JOURNAL_H
+#define CHANGE_JOURNAL_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Registro acotado de celdas modificadas
+// Qué sucede: Guarda en un búfer circular pares (versión, celda) para los últimos `capacity` cambios.
+// Por qué sucede: Las cachés pueden preguntar qué celdas cambiaron desde la versión con la que calcularon un dato y
+//                 descartar solo lo que esas celdas afectan.
+// Qué deberíamos esperar: Si el historial pedido ya se perdió (búfer lleno o `reset`), la consulta devuelve `false`
+//                         y quien pregunta debe tratar el dato como inválido.
+class ChangeJournal {
+public:
+    explicit ChangeJournal(std::size_t capacity = 4096);
+
+    // Anotar que `cell` cambió al pasar a la versión `version`.
+    void record(std::uint64_t version, int cell);
+
+    // Olvidar todo el historial: cualquier dato anterior a `version` deja de poder validarse.
+    // Por qué sucede: Se usa tras cambios masivos (por ejemplo, regenerar todos los obstáculos).
+    void reset(std::uint64_t version);
+
+    // Celdas cambiadas después de `version`
+    // Qué sucede: Agrega a `cells` las celdas anotadas con versión mayor que `version`.
+    // Qué deberíamos esperar: `false` si el historial no cubre desde `version`.
+    bool changesSince(std::uint64_t version, std::vector<int>& cells) const;
+
+    // Obtener un sello de versión nuevo
+    // Qué sucede: Incrementa un contador atómico global compartido por mapas y capas de ocupación.
+    // Por qué sucede: Dos estructuras distintas nunca comparten versión, así que una caché no confunde sus datos.
+    static std::uint64_t newVersion();
+
+private:
+    struct Change {
+        std::uint64_t version;
+        int cell;
+    };
+
+    std::vector<Change> ring;  // Búfer circular de cambios
+    std::size_t next;  // Posición donde se escribirá el próximo cambio
+    std::size_t count;  // Cantidad de cambios válidos en el búfer
+    std::uint64_t floor;  // Versión más antigua desde la que el historial está completo
+};
+
+#endif
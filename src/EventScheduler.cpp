@@ -0,0 +1,29 @@
+#include "EventScheduler.h"
+#include <algorithm>
+#include <limits>
+
+// Comparador del heap: menor tick primero; ante empates, menor tipo y luego el programado antes
+static bool eventCompare(const ScheduledEvent& a, const ScheduledEvent& b) {
+    if (a.tick != b.tick) return a.tick > b.tick;
+    if (a.type != b.type) return a.type > b.type;
+    return a.sequence > b.sequence;
+}
+
+void EventScheduler::schedule(std::uint64_t tick, EventType type, std::uint64_t payload) {
+    heap.push_back({tick, type, payload, nextSequence++});
+    std::push_heap(heap.begin(), heap.end(), eventCompare);
+}
+
+bool EventScheduler::popDue(std::uint64_t now, ScheduledEvent& event) {
+    if (heap.empty() || heap.front().tick > now) {
+        return false;
+    }
+    std::pop_heap(heap.begin(), heap.end(), eventCompare);
+    event = heap.back();
+    heap.pop_back();
+    return true;
+}
+
+std::uint64_t EventScheduler::nextTick() const {
+    return heap.empty() ? std::numeric_limits<std::uint64_t>::max() : heap.front().tick;
+}
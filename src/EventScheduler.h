@@ -0,0 +1,51 @@
+#ifndef EVENT_SCHEDULER_H
+#define EVENT_SCHEDULER_H
+
+#include <vector>
+#include <cstdint>
+
+// Tipos de eventos programados de la partida
+// Qué sucede: El orden del enum es la prioridad entre eventos del mismo tick (el reloj se revisa antes que el turno).
+enum EventType {
+    EVENT_CLOCK,  // El segundo mostrado del reloj global cambia
+    EVENT_POWER_UP,  // Sorteo de un power-up para el jugador actual
+    EVENT_TURN_END  // Se cumple el tiempo del turno
+};
+
+// Evento programado para un tick
+// Qué sucede: `payload` es un dato libre del evento (por ejemplo, el número de turno que lo programó).
+struct ScheduledEvent {
+    std::uint64_t tick;
+    EventType type;
+    std::uint64_t payload;
+    std::uint64_t sequence;  // Orden de programación; desempata eventos iguales
+};
+
+// Planificador de eventos por tick (min-heap)
+// Qué sucede: Guarda los eventos ordenados por tick y entrega solo los que ya vencieron.
+// Por qué sucede: El cambio de turno, los power-ups y el reloj se revisaban en todos los ticks aunque casi nunca
+//                 cambiaran; con el heap, un tick sin eventos vencidos solo compara la cima.
+// Qué deberíamos esperar: `popDue` devuelve los eventos en orden de tick, tipo y programación, así que la partida es
+//                         la misma con cualquier cantidad de frames por segundo.
+class EventScheduler {
+public:
+    // Programar un evento para `tick`.
+    void schedule(std::uint64_t tick, EventType type, std::uint64_t payload = 0);
+
+    // Sacar el próximo evento vencido
+    // Qué deberíamos esperar: `false` si no hay eventos con tick menor o igual a `now`.
+    bool popDue(std::uint64_t now, ScheduledEvent& event);
+
+    // Tick del próximo evento, o el máximo de `uint64_t` si no hay ninguno.
+    std::uint64_t nextTick() const;
+
+    bool empty() const { return heap.empty(); }
+    std::size_t size() const { return heap.size(); }
+    void clear() { heap.clear(); }
+
+private:
+    std::vector<ScheduledEvent> heap;
+    std::uint64_t nextSequence = 0;
+};
+
+#endif
@@ -0,0 +1,31 @@
+#include "FixedTimestep.h"
+
+// Constructor
+// Qué sucede: Empieza con el acumulador vacío.
+FixedTimestep::FixedTimestep(double tickSeconds, int maxTicksPerFrame)
+    : tickSeconds(tickSeconds), maxTicksPerFrame(maxTicksPerFrame), accumulator(0.0), tickCount(0),
+      droppedSeconds(0.0) {}
+
+// Acumular el tiempo de un frame
+// Qué sucede: Resta un tick del acumulador por cada tick devuelto.
+// Qué deberíamos esperar: Lo que queda en el acumulador es menor que un tick, incluso si se alcanzó el máximo.
+int FixedTimestep::advance(double frameSeconds) {
+    if (frameSeconds > 0.0) {
+        accumulator += frameSeconds;
+    }
+
+    int ticks = 0;
+    while (accumulator >= tickSeconds && ticks < maxTicksPerFrame) {
+        accumulator -= tickSeconds;
+        ++ticks;
+    }
+
+    if (accumulator >= tickSeconds) {
+        double excess = static_cast<long long>(accumulator / tickSeconds) * tickSeconds;
+        droppedSeconds += excess;
+        accumulator -= excess;
+    }
+
+    tickCount += ticks;
+    return ticks;
+}
@@ -0,0 +1,47 @@
+#ifndef FIXED_TIMESTEP_H
+#define FIXED_TIMESTEP_H
+
+#include <cstdint>
+
+// Paso de simulación fijo con acumulador
+// Qué sucede: Acumula el tiempo real de cada frame y lo convierte en una cantidad entera de ticks de duración fija.
+// Por qué sucede: Las balas y las rutas avanzaban una vez por frame dibujado, así que la velocidad del juego dependía
+//                 de los FPS y un frame lento frenaba la simulación.
+// Qué deberíamos esperar: La simulación avanza `1 / tickSeconds` ticks por segundo sin importar los FPS. `getAlpha`
+//                         indica cuánto se avanzó hacia el siguiente tick para interpolar el dibujo.
+class FixedTimestep {
+public:
+    // Constructor
+    // Qué sucede: `tickSeconds` es la duración de un tick; `maxTicksPerFrame` limita los ticks que se recuperan en un
+    //             solo frame.
+    explicit FixedTimestep(double tickSeconds = 1.0 / 60.0, int maxTicksPerFrame = 8);
+
+    // Acumular el tiempo de un frame
+    // Qué sucede: Suma `frameSeconds` al acumulador y devuelve cuántos ticks hay que simular ahora.
+    // Por qué sucede: Si un frame tardó mucho, se simulan varios ticks seguidos para ponerse al día.
+    // Qué deberíamos esperar: Como máximo `maxTicksPerFrame`; el atraso que sobra se descarta para no entrar en una
+    //                         espiral en la que cada frame tarda más que el anterior.
+    int advance(double frameSeconds);
+
+    // Fracción del siguiente tick ya acumulada, entre 0 y 1.
+    double getAlpha() const { return accumulator / tickSeconds; }
+
+    double getTickSeconds() const { return tickSeconds; }
+    int getMaxTicksPerFrame() const { return maxTicksPerFrame; }
+    void setMaxTicksPerFrame(int ticks) { maxTicksPerFrame = ticks; }
+
+    // Cantidad de ticks simulados desde la creación.
+    std::uint64_t getTickCount() const { return tickCount; }
+
+    // Tiempo descartado por superar `maxTicksPerFrame` (en segundos).
+    double getDroppedSeconds() const { return droppedSeconds; }
+
+private:
+    double tickSeconds;  // Duración de un tick
+    int maxTicksPerFrame;  // Ticks máximos por frame
+    double accumulator;  // Tiempo acumulado que todavía no se simuló
+    std::uint64_t tickCount;  // Ticks simulados
+    double droppedSeconds;  // Atraso descartado
+};
+
+#endif
@@ -0,0 +1,162 @@
+#include "FlowField.h"
+
+// Desplazamientos asociados a cada bit de la máscara de vecinos
+// Qué sucede: `opposite` es el bit que apunta de vuelta desde el vecino a la celda actual.
+// Por qué sucede: Al inundar desde el objetivo, cada celda nueva debe apuntar hacia la celda que la descubrió.
+struct FlowDirection {
+    int dx;
+    int dy;
+    std::uint8_t bit;
+    std::uint8_t opposite;
+};
+
+static const FlowDirection kFlowDirections[4] = {
+    {0, 1, Map::NEIGHBOR_DOWN, Map::NEIGHBOR_UP},
+    {1, 0, Map::NEIGHBOR_RIGHT, Map::NEIGHBOR_LEFT},
+    {0, -1, Map::NEIGHBOR_UP, Map::NEIGHBOR_DOWN},
+    {-1, 0, Map::NEIGHBOR_LEFT, Map::NEIGHBOR_RIGHT}
+};
+
+// Constructor
+// Qué sucede: Crea un campo vacío; `isCurrent` devuelve `false` hasta llamar a `compute`.
+FlowField::FlowField() : size(0), targetX(-1), targetY(-1), mapVersion(0) {}
+
+// Calcular el campo de flujo
+// Qué sucede: BFS desde el objetivo; cada celda descubierta guarda su distancia y el bit que apunta a su padre.
+// Por qué sucede: Seguir esos bits desde cualquier celda lleva al objetivo por una ruta más corta.
+// Qué deberíamos esperar: O(celdas) una sola vez por objetivo y versión del terreno.
+void FlowField::compute(const Map& map, int x, int y) {
+    size = map.getSize();
+    targetX = x;
+    targetY = y;
+    mapVersion = map.getVersion();
+    distance.assign(size * size, UNREACHABLE);
+    direction.assign(size * size, 0);
+
+    if (!map.isValidPosition(targetX, targetY)) {
+        return;
+    }
+
+    // La cola reutiliza un solo vector recorrido con un índice de cabeza
+    std::vector<int> queue;
+    queue.reserve(size * size);
+    int targetIndex = map.cellIndex(targetX, targetY);
+    distance[targetIndex] = 0;
+    queue.push_back(targetIndex);
+
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int current = queue[head];
+        int cx = current % size;
+        int cy = current / size;
+        std::uint8_t mask = map.getNeighborMask(cx, cy);
+        for (const FlowDirection& dir : kFlowDirections) {
+            if (!(mask & dir.bit)) {
+                continue;
+            }
+            int next = current + dir.dy * size + dir.dx;
+            if (distance[next] == UNREACHABLE) {
+                distance[next] = distance[current] + 1;
+                direction[next] = dir.opposite;
+                queue.push_back(next);
+            }
+        }
+    }
+}
+
+// Verificar vigencia del campo
+// Qué sucede: El campo es válido si el mapa tiene el mismo tamaño y versión que al calcularlo.
+bool FlowField::isCurrent(const Map& map) const {
+    return size == map.getSize() && mapVersion == map.getVersion() && !distance.empty();
+}
+
+// Distancia al objetivo
+int FlowField::getDistance(int x, int y) const {
+    if (!inBounds(x, y)) {
+        return UNREACHABLE;
+    }
+    return distance[y * size + x];
+}
+
+// Siguiente paso hacia el objetivo
+// Qué sucede: Traduce el bit de dirección guardado en la celda vecina correspondiente.
+bool FlowField::nextStep(int x, int y, Cell& next) const {
+    if (!inBounds(x, y)) {
+        return false;
+    }
+    std::uint8_t bit = direction[y * size + x];
+    for (const FlowDirection& dir : kFlowDirections) {
+        if (dir.bit == bit) {
+            next = {x + dir.dx, y + dir.dy};
+            return true;
+        }
+    }
+    return false;
+}
+
+// Ruta completa hacia el objetivo
+// Qué sucede: Reserva la longitud exacta (la distancia guardada) y sigue las direcciones paso a paso.
+std::vector<Cell> FlowField::extractPath(int x, int y) const {
+    int steps = getDistance(x, y);
+    if (steps == UNREACHABLE) {
+        return {};
+    }
+
+    std::vector<Cell> path;
+    path.reserve(steps + 1);
+    Cell at = {x, y};
+    path.push_back(at);
+    while (nextStep(at.x, at.y, at)) {
+        path.push_back(at);
+    }
+    return path;
+}
+
+// Constructor de la caché
+FlowFieldCache::FlowFieldCache(std::size_t capacity)
+    : capacity(capacity == 0 ? 1 : capacity), useCounter(0), hits(0), misses(0) {}
+
+// Obtener un campo de la caché
+// Qué sucede: Busca un campo con el mismo objetivo; si está vigente lo devuelve, si no lo recalcula en su lugar.
+//             Si no existe, ocupa un lugar libre o reemplaza el menos usado recientemente.
+// Por qué sucede: Reutilizar la entrada obsoleta evita reservar otro arreglo del tamaño del mapa.
+const FlowField& FlowFieldCache::get(const Map& map, int targetX, int targetY) {
+    ++useCounter;
+
+    Entry* slot = nullptr;
+    for (Entry& entry : entries) {
+        if (entry.field.getTargetX() == targetX && entry.field.getTargetY() == targetY) {
+            slot = &entry;
+            break;
+        }
+    }
+
+    if (slot != nullptr && slot->field.isCurrent(map)) {
+        ++hits;
+        slot->lastUse = useCounter;
+        return slot->field;
+    }
+
+    ++misses;
+    if (slot == nullptr) {
+        if (entries.size() < capacity) {
+            entries.push_back({FlowField(), 0});
+            slot = &entries.back();
+        } else {
+            slot = &entries.front();
+            for (Entry& entry : entries) {
+                if (entry.lastUse < slot->lastUse) {
+                    slot = &entry;
+                }
+            }
+        }
+    }
+
+    slot->field.compute(map, targetX, targetY);
+    slot->lastUse = useCounter;
+    return slot->field;
+}
+
+// Vaciar la caché
+void FlowFieldCache::clear() {
+    entries.clear();
+}
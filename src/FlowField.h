@@ -0,0 +1,90 @@
+#ifndef FLOW_FIELD_H
+#define FLOW_FIELD_H
+
+#include "Map.h"
+#include "Pathfinding.h"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Campo de flujo (campo de distancias) hacia un objetivo
+// Qué sucede: Un BFS inverso desde el objetivo guarda, para cada celda libre, su distancia al objetivo y la dirección
+//             del siguiente paso.
+// Por qué sucede: Cuando muchos tanques van a la misma celda, una sola inundación sirve a todos en lugar de repetir
+//                 un BFS/Dijkstra por tanque.
+// Qué deberíamos esperar: `nextStep` en O(1) y `extractPath` en O(longitud de la ruta) desde cualquier celda.
+//                         El campo solo considera el terreno; quien mueve el tanque debe comprobar la ocupación.
+class FlowField {
+public:
+    static constexpr int UNREACHABLE = -1;
+
+    FlowField();
+
+    // Calcular el campo hacia un objetivo
+    // Qué sucede: Inunda el mapa desde `(targetX, targetY)` siguiendo las máscaras de vecinos.
+    // Por qué sucede: El grafo es no dirigido, así que el BFS desde el objetivo da la distancia de cada celda hacia él.
+    void compute(const Map& map, int targetX, int targetY);
+
+    // Verificar si el campo corresponde al estado actual del mapa
+    // Qué sucede: Compara el tamaño y la versión del terreno con los usados al calcularlo.
+    bool isCurrent(const Map& map) const;
+
+    // Distancia de una celda al objetivo en pasos, o `UNREACHABLE`.
+    int getDistance(int x, int y) const;
+
+    // Siguiente paso hacia el objetivo
+    // Qué sucede: Escribe en `next` la celda vecina que acerca al objetivo.
+    // Qué deberíamos esperar: `false` si la celda es inalcanzable, está fuera del mapa o ya es el objetivo.
+    bool nextStep(int x, int y, Cell& next) const;
+
+    // Ruta completa hacia el objetivo
+    // Qué sucede: Sigue las direcciones desde `(x, y)` hasta el objetivo.
+    // Qué deberíamos esperar: El mismo formato que `bfs()` (incluye inicio y destino), o vacía si no hay ruta.
+    std::vector<Cell> extractPath(int x, int y) const;
+
+    int getTargetX() const { return targetX; }
+    int getTargetY() const { return targetY; }
+    std::uint64_t getMapVersion() const { return mapVersion; }
+
+private:
+    int size;  // Tamaño del mapa para el que se calculó
+    int targetX, targetY;  // Celda objetivo
+    std::uint64_t mapVersion;  // Versión del terreno al calcular el campo
+    std::vector<int> distance;  // Distancia al objetivo por celda (fila por fila)
+    std::vector<std::uint8_t> direction;  // Bit `Map::NeighborBit` hacia el siguiente paso, 0 si no hay
+
+    bool inBounds(int x, int y) const { return x >= 0 && x < size && y >= 0 && y < size; }
+};
+
+// Caché de campos de flujo por objetivo
+// Qué sucede: Guarda hasta `capacity` campos, identificados por celda objetivo y versión del mapa; al llenarse
+//             reemplaza el menos usado recientemente.
+// Por qué sucede: Cada campo ocupa memoria proporcional al mapa, así que la caché debe estar acotada.
+// Qué deberíamos esperar: Pedir el mismo objetivo sin cambios en el terreno no vuelve a inundar el mapa.
+class FlowFieldCache {
+public:
+    explicit FlowFieldCache(std::size_t capacity = 8);
+
+    // Obtener el campo hacia un objetivo
+    // Qué sucede: Devuelve el campo guardado si sigue vigente; si no, lo calcula y lo guarda.
+    // Qué deberíamos esperar: La referencia es válida hasta la siguiente llamada a `get` o `clear`.
+    const FlowField& get(const Map& map, int targetX, int targetY);
+
+    void clear();
+
+    std::size_t getHits() const { return hits; }
+    std::size_t getMisses() const { return misses; }
+
+private:
+    struct Entry {
+        FlowField field;
+        std::uint64_t lastUse;
+    };
+
+    std::size_t capacity;  // Cantidad máxima de campos guardados
+    std::vector<Entry> entries;  // Campos guardados
+    std::uint64_t useCounter;  // Reloj lógico para el reemplazo LRU
+    std::size_t hits, misses;  // Estadísticas de la caché
+};
+
+#endif
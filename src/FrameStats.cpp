@@ -0,0 +1,39 @@
+#include "FrameStats.h"
+#include <algorithm>
+#include <chrono>
+
+FrameStats::FrameStats() : idleSeconds(0.0), cpuStart(std::clock()), wallStart(wallNow()) {
+    frameSeconds.reserve(1 << 16);
+}
+
+double FrameStats::wallNow() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void FrameStats::recordFrame(double seconds) {
+    frameSeconds.push_back(static_cast<float>(seconds));
+}
+
+// Escribir el resumen
+// Qué sucede: Ordena una copia de las duraciones para obtener los percentiles; `std::clock` mide el tiempo de CPU de
+//             todo el proceso.
+void FrameStats::report(std::ostream& out) const {
+    double wall = wallNow() - wallStart;
+    double cpu = static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+
+    out << "Frames: " << frameSeconds.size();
+    if (!frameSeconds.empty()) {
+        std::vector<float> sorted = frameSeconds;
+        std::sort(sorted.begin(), sorted.end());
+        double total = 0.0;
+        for (float seconds : sorted) {
+            total += seconds;
+        }
+        out << ", frame medio: " << total / sorted.size() * 1000.0 << " ms"
+            << ", p50: " << sorted[sorted.size() / 2] * 1000.0 << " ms"
+            << ", p99: " << sorted[std::min(sorted.size() - 1, sorted.size() * 99 / 100)] * 1000.0 << " ms"
+            << ", máximo: " << sorted.back() * 1000.0 << " ms";
+    }
+    out << "\nTiempo real: " << wall << " s, CPU: " << cpu << " s ("
+        << (wall > 0 ? cpu / wall * 100.0 : 0.0) << "%), en espera: " << idleSeconds << " s\n";
+}
@@ -0,0 +1,35 @@
+#ifndef FRAME_STATS_H
+#define FRAME_STATS_H
+
+#include <vector>
+#include <ctime>
+#include <ostream>
+
+// Medición de frames y uso de CPU
+// Qué sucede: Guarda la duración de cada frame y, al final, compara el tiempo de CPU del proceso con el tiempo real.
+// Por qué sucede: Para comprobar que el límite de frames y el modo de espera realmente liberan el núcleo.
+// Qué deberíamos esperar: Un resumen con frames, duración media, percentiles 50/99, máximo y porcentaje de CPU
+//                         (100% equivale a un núcleo ocupado todo el tiempo).
+class FrameStats {
+public:
+    FrameStats();
+
+    // Registrar la duración de un frame (en segundos).
+    void recordFrame(double seconds);
+
+    // Registrar tiempo pasado esperando eventos en modo de espera.
+    void recordIdle(double seconds) { idleSeconds += seconds; }
+
+    // Escribir el resumen.
+    void report(std::ostream& out) const;
+
+private:
+    std::vector<float> frameSeconds;  // Duración de cada frame
+    double idleSeconds;  // Tiempo total en espera
+    std::clock_t cpuStart;  // Tiempo de CPU del proceso al empezar
+    double wallStart;  // Tiempo real al empezar
+
+    static double wallNow();
+};
+
+#endif
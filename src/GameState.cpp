@@ -0,0 +1,513 @@
+#include "GameState.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <iostream>
+
+// Tomar el tamaño del mapa del archivo
+// Qué sucede: Si la configuración indica un archivo de mapa, lo abre (salvo que ya venga abierto en `mapFile`) y su
+//             tamaño reemplaza a `mapSize`; si no se puede abrir o es demasiado chico para los tanques, se avisa y se
+//             genera un mapa como siempre.
+// Por qué sucede: El archivo se abre y se valida una sola vez; el constructor carga el mapa de este mismo `mapFile`,
+//                 así que no puede cambiar entre leer el tamaño y cargarlo.
+static GameConfig resolveMapFile(GameConfig config) {
+    if (!config.mapPath.empty()) {
+        if (!config.mapFile) {
+            config.mapFile = MapFile::open(config.mapPath);
+        }
+        if (config.mapFile && config.mapFile->getSize() >= GameState::MIN_MAP_SIZE) {
+            config.mapSize = config.mapFile->getSize();
+        } else {
+            std::cerr << "No se pudo cargar el mapa " << config.mapPath << "; se genera uno nuevo\n";
+            config.mapPath.clear();
+            config.mapFile.reset();
+        }
+    } else {
+        config.mapFile.reset();
+    }
+    config.mapSize = std::max(config.mapSize, GameState::MIN_MAP_SIZE);
+    return config;
+}
+
+// Celdas de la zona libre principal
+// Qué sucede: Cuenta las celdas de cada componente del mapa y devuelve, en orden de índice, las de la más grande.
+// Por qué sucede: Un mapa generado tiene una sola zona, pero uno cargado de archivo puede tener zonas aisladas; un
+//                 tanque que empieza en una de ellas no puede llegar al rival.
+static std::vector<int> mainRegionCells(const Map& map) {
+    int cellCount = map.getSize() * map.getSize();
+    const std::int32_t* labels = map.getComponentLabels();
+    std::vector<int> cellsPerComponent;
+    int main = -1;
+    for (int index = 0; index < cellCount; ++index) {
+        int label = labels[index];
+        if (label < 0) {
+            continue;
+        }
+        if (label >= static_cast<int>(cellsPerComponent.size())) {
+            cellsPerComponent.resize(label + 1, 0);
+        }
+        if (++cellsPerComponent[label] > (main == -1 ? 0 : cellsPerComponent[main])) {
+            main = label;
+        }
+    }
+
+    std::vector<int> cells;
+    if (main != -1) {
+        cells.reserve(cellsPerComponent[main]);
+        for (int index = 0; index < cellCount; ++index) {
+            if (labels[index] == main) {
+                cells.push_back(index);
+            }
+        }
+    }
+    return cells;
+}
+
+// Constructor
+// Qué sucede: Carga o genera el mapa y coloca los tanques de cada jugador en su mitad del mapa.
+// Qué deberíamos esperar: El jugador 1 empieza con 2 tanques azules y 2 rojos a la izquierda, y el jugador 2 con
+//                         2 celestes y 2 amarillos a la derecha.
+GameState::GameState(const GameConfig& requested)
+    : config(resolveMapFile(requested)), rng(config.seed), map(config.mapSize), occupancy(config.mapSize),
+      currentPlayer(1), selectedTankId(-1), waitingForBFSClick(false), waitingForAStarClick(false),
+      powerUsed(false), selectedPower('\0'), shootingMode(false), hasShot(false),
+      playerPowerUp{NONE, NONE}, isPowerUpActive(false), powerUpActivated(false), powerUpConsumed(false),
+      turnControl{0, 0}, matchTicks(0), turnLengthTicks(secondsToTicks(config.turnSeconds)),
+      powerUpTicks(secondsToTicks(config.powerUpSeconds)), turnNumber(0),
+      remainingSeconds(remainingSecondsAt(0)), gameOver(false), winner(0) {
+    // Un mapa cargado se lee del archivo sin copiarlo; `obstaclePercentage`, `mapStrategy` y `terrainPercentage` no se usan
+    if (!config.mapFile || !map.load(config.mapFile)) {
+        map = Map(config.mapSize);
+        GeneratorConfig generatorConfig;
+        generatorConfig.strategy = config.mapStrategy;
+        generatorConfig.obstaclePercentage = config.obstaclePercentage;
+        generatorConfig.terrainPercentage = config.terrainPercentage;
+        MapGenerator().generate(map, generatorConfig, rng.next());
+    }
+
+    // Reservar antes de colocar: los tanques no deben moverse en memoria mientras se registran en la ocupación
+    tanks.reserve(8);
+    std::vector<int> spawnCells = mainRegionCells(map);
+    int half = config.mapSize / 2;
+    placeTanks(Tank::BLUE, 2, 0, 0, half - 1, spawnCells);
+    placeTanks(Tank::RED, 2, 2, 0, half - 1, spawnCells);
+    placeTanks(Tank::CYAN, 2, 4, half, config.mapSize - 1, spawnCells);
+    placeTanks(Tank::YELLOW, 2, 6, half, config.mapSize - 1, spawnCells);
+
+    // Programar los primeros eventos: fin del primer turno, primer sorteo de power-up y primer cambio del reloj
+    events.schedule(turnLengthTicks, EVENT_TURN_END, turnNumber);
+    events.schedule(powerUpTicks, EVENT_POWER_UP);
+    scheduleClock();
+}
+
+// Convertir segundos a ticks
+// Qué sucede: Devuelve el menor `n >= 1` con `n * tickSeconds >= seconds`, la misma comparación que usaban los
+//             temporizadores revisados en cada tick.
+std::uint64_t GameState::secondsToTicks(double seconds) const {
+    std::uint64_t ticks = seconds > config.tickSeconds ? static_cast<std::uint64_t>(seconds / config.tickSeconds) : 1;
+    while (ticks > 1 && (ticks - 1) * config.tickSeconds >= seconds) {
+        --ticks;
+    }
+    while (ticks * config.tickSeconds < seconds) {
+        ++ticks;
+    }
+    return ticks;
+}
+
+// Segundos enteros que quedan de partida en un tick (truncados, como los muestra el reloj).
+int GameState::remainingSecondsAt(std::uint64_t tick) const {
+    return static_cast<int>(config.matchSeconds - tick * config.tickSeconds);
+}
+
+// Programar el próximo cambio del reloj
+// Qué sucede: Busca el primer tick en el que el segundo mostrado baja de `remainingSeconds`.
+// Qué deberíamos esperar: Un evento por segundo de partida; el último llega cuando el reloj marca 0.
+void GameState::scheduleClock() {
+    std::uint64_t tick = matchTicks + 1;
+    if (remainingSeconds > 0) {
+        double elapsed = config.matchSeconds - remainingSeconds;
+        tick = std::max(tick, static_cast<std::uint64_t>(elapsed / config.tickSeconds));
+        while (tick > matchTicks + 1 && remainingSecondsAt(tick - 1) < remainingSeconds) {
+            --tick;
+        }
+        while (remainingSecondsAt(tick) >= remainingSeconds) {
+            ++tick;
+        }
+    }
+    events.schedule(tick, EVENT_CLOCK);
+}
+
+// Colocar tanques de un color
+// Qué sucede: Cada tanque va a una celda de `cells` al azar con `minX <= x <= maxX` que no esté ocupada. Primero se
+//             prueban unas pocas celdas al azar; si ninguna sirve, se juntan todas las candidatas y se elige entre
+//             ellas, y si esa mitad no tiene ninguna, se acepta cualquier celda libre de `cells`. Si tampoco hay, se
+//             usa cualquier celda sin tanque (aunque sea un obstáculo), y si el mapa está lleno el tanque no se crea.
+// Por qué sucede: En mapas grandes casi siempre acierta al primer intento sin recorrer `cells`.
+void GameState::placeTanks(Tank::Color color, int count, int firstId, int minX, int maxX,
+                           const std::vector<int>& cells) {
+    const int size = config.mapSize;
+    auto available = [&](int index, bool anyColumn) {
+        int x = index % size;
+        return (anyColumn || (x >= minX && x <= maxX)) && !occupancy.isOccupied(x, index / size);
+    };
+
+    std::vector<int> candidates;
+    for (int i = 0; i < count; ++i) {
+        int chosen = -1;
+        for (int attempt = 0; attempt < 16 && chosen == -1 && !cells.empty(); ++attempt) {
+            int index = cells[rng.below(static_cast<std::uint32_t>(cells.size()))];
+            chosen = available(index, false) ? index : -1;
+        }
+        for (int pass = 0; pass < 2 && chosen == -1; ++pass) {
+            candidates.clear();
+            for (int index : cells) {
+                if (available(index, pass == 1)) {
+                    candidates.push_back(index);
+                }
+            }
+            if (!candidates.empty()) {
+                chosen = candidates[rng.below(static_cast<std::uint32_t>(candidates.size()))];
+            }
+        }
+
+        // Mapa sin celdas libres suficientes: se mira solo la ocupación, primero en la mitad y después en todo el mapa
+        for (int pass = 0; pass < 2 && chosen == -1; ++pass) {
+            candidates.clear();
+            for (int index = 0; index < size * size; ++index) {
+                if (available(index, pass == 1)) {
+                    candidates.push_back(index);
+                }
+            }
+            if (!candidates.empty()) {
+                chosen = candidates[rng.below(static_cast<std::uint32_t>(candidates.size()))];
+            }
+        }
+        if (chosen == -1) {
+            return;
+        }
+        int x = chosen % size;
+        int y = chosen / size;
+        tanks.emplace_back(color, x, y, firstId + i);
+        tanks.back().attachOccupancy(&occupancy);
+    }
+}
+
+bool GameState::belongsToPlayer(const Tank& tank, int player) {
+    if (player == 1) {
+        return tank.getColor() == Tank::BLUE || tank.getColor() == Tank::RED;
+    }
+    return tank.getColor() == Tank::CYAN || tank.getColor() == Tank::YELLOW;
+}
+
+// Contar los tanques vivos de un jugador
+// Qué sucede: Cuenta cuántos tanques del jugador están aún activos.
+// Por qué sucede: Para determinar si un jugador ha perdido todos sus tanques.
+int GameState::countAliveTanks(int player) const {
+    int count = 0;
+    for (const Tank& tank : tanks) {
+        if (!tank.isDestroyed() && belongsToPlayer(tank, player)) {
+            count++;
+        }
+    }
+    return count;
+}
+
+// Buscar el tanque seleccionado
+// Qué sucede: La selección se guarda por ID, así que sigue siendo válida aunque el vector de tanques cambie.
+// Qué deberíamos esperar: `nullptr` si no hay selección o el tanque ya fue retirado.
+Tank* GameState::selectedTank() {
+    if (selectedTankId < 0) {
+        return nullptr;
+    }
+    for (Tank& tank : tanks) {
+        if (tank.getId() == selectedTankId) {
+            return &tank;
+        }
+    }
+    return nullptr;
+}
+
+const Tank* GameState::getSelectedTank() const {
+    return const_cast<GameState*>(this)->selectedTank();
+}
+
+// Avanzar un tick
+void GameState::step(const std::vector<GameInput>& inputs) {
+    if (gameOver) {
+        return;
+    }
+
+    for (const GameInput& input : inputs) {
+        switch (input.type) {
+            case INPUT_CLICK:    handleClick(input.x, input.y); break;
+            case INPUT_MOVE:     handleMoveKey(); break;
+            case INPUT_SHOOT:    handleShootKey(); break;
+            case INPUT_POWER_UP: handlePowerUpKey(); break;
+        }
+    }
+
+    simulateTick();
+}
+
+// Verificar un destino de movimiento
+// Qué sucede: El destino debe estar en la misma componente que el tanque (`Map::isReachable`); si es una celda libre
+//             de otra zona se avisa y se sigue esperando otro clic, igual que con un obstáculo.
+// Por qué sucede: Sin esta consulta, la búsqueda recorría toda la zona del tanque para terminar sin ruta.
+bool GameState::isReachableDestination(const Tank& tank, int x, int y) const {
+    if (map.isReachable(tank.getX(), tank.getY(), x, y)) {
+        return true;
+    }
+    if (config.verbose && map.isValidPosition(x, y)) {
+        std::cout << "Destino inalcanzable: (" << x << ", " << y << ")\n";
+    }
+    return false;
+}
+
+// Clic en una celda
+// Qué sucede: Según el estado del turno, el clic define el destino de la ruta, selecciona un tanque o dispara.
+// Por qué sucede: Cada turno, un jugador debe poder seleccionar y mover sus tanques y elegir a quién atacar.
+// Qué deberíamos esperar: El tanque seleccionado queda listo para moverse, recibe una ruta o dispara hacia la celda.
+void GameState::handleClick(int x, int y) {
+    Tank* tank = selectedTank();
+
+    if (waitingForBFSClick && tank != nullptr) {
+        // Mover el tanque usando BFS si se hace clic en un destino válido y alcanzable
+        if (!occupancy.isOccupied(x, y) && isReachableDestination(*tank, x, y)) {
+            currentPath = pathCache.findPath(PATH_BFS, map, occupancy, tank->getX(), tank->getY(), x, y);
+            waitingForBFSClick = false;  // Terminar la espera para el clic
+        }
+    } else if (waitingForAStarClick && tank != nullptr) {
+        // Mover el tanque por la ruta de menor costo de terreno si se hace clic en un destino válido
+        // A* da la misma ruta de menor costo que Dijkstra expandiendo muchos menos nodos
+        if (!occupancy.isOccupied(x, y) && isReachableDestination(*tank, x, y)) {
+            currentPath = pathCache.findPath(PATH_ASTAR, map, occupancy, tank->getX(), tank->getY(), x, y);
+            waitingForAStarClick = false;  // Terminar la espera para el clic
+        }
+    } else if (tank == nullptr) {
+        // Seleccionar un tanque del jugador actual si no estamos esperando para BFS o A*
+        int tankId = occupancy.tankAt(x, y);
+        for (const Tank& candidate : tanks) {
+            if (candidate.getId() == tankId && belongsToPlayer(candidate, currentPlayer)) {
+                selectedTankId = tankId;
+                if (config.verbose) {
+                    std::cout << "Tanque seleccionado en (" << x << ", " << y << ")\n";
+                }
+                break;
+            }
+        }
+    }
+
+    // Clic en el objetivo durante el modo disparo
+    // Qué sucede: El tanque dispara hacia la celda seleccionada.
+    // Qué deberíamos esperar: Una bala que viaja hacia el objetivo.
+    if (shootingMode && !hasShot && tank != nullptr) {
+        bullets.spawn(tank->getX(), tank->getY(), x, y, tank->getId());
+
+        // Salir del modo disparo y marcar que se ha disparado en este turno
+        shootingMode = false;
+        hasShot = true;
+    }
+}
+
+// Tecla M: mover el tanque seleccionado
+// Qué sucede: Los tanques azul/celeste usan BFS (menos celdas) la mitad de las veces y los rojo/amarillo A*
+//             (menor costo de terreno: siguen los caminos y rodean el barro) el 80%; el resto se mueven al azar.
+// Por qué sucede: Los tanques deben ser capaces de moverse en el campo de batalla.
+void GameState::handleMoveKey() {
+    Tank* tank = selectedTank();
+    if (tank == nullptr || powerUsed || selectedPower != '\0') {
+        return;
+    }
+
+    selectedPower = 'M';
+    powerUsed = true;
+    if (tank->getColor() == Tank::BLUE || tank->getColor() == Tank::CYAN) {
+        int randomDecision = rng.below(2);
+        if (randomDecision == 0) {
+            if (config.verbose) std::cout << "Usando BFS para mover tanque azul/celeste\n";
+            waitingForBFSClick = true;  // Esperar clic para definir destino
+        } else {
+            if (config.verbose) std::cout << "Usando movimiento aleatorio para tanque azul/celeste\n";
+            currentPath = moveRandomly(tank->getX(), tank->getY(), map, occupancy, rng);
+        }
+    } else {
+        int randomDecision = rng.below(10);
+        if (randomDecision < 8) {
+            if (config.verbose) std::cout << "Usando A* para mover tanque rojo/amarillo\n";
+            waitingForAStarClick = true;  // Esperar clic para definir destino
+        } else {
+            if (config.verbose) std::cout << "Usando movimiento aleatorio para tanque rojo/amarillo\n";
+            currentPath = moveRandomly(tank->getX(), tank->getY(), map, occupancy, rng);
+        }
+    }
+}
+
+// Tecla D: activar el modo disparo
+// Qué sucede: El siguiente clic define el objetivo de la bala.
+// Por qué sucede: Los tanques necesitan atacar para eliminar a los enemigos.
+void GameState::handleShootKey() {
+    if (selectedTank() == nullptr || powerUsed || powerUpActivated || selectedPower != '\0') {
+        return;
+    }
+    selectedPower = 'D';
+    powerUsed = true;
+    shootingMode = true;  // Activar el modo disparo
+    if (config.verbose) {
+        std::cout << "Modo disparo activado\n";
+    }
+}
+
+// Tecla P: activar el power-up
+// Qué sucede: Se activa el power-up del jugador actual si está disponible.
+// Por qué sucede: Los power-ups permiten obtener ventajas estratégicas durante el juego.
+void GameState::handlePowerUpKey() {
+    if (powerUsed) {
+        return;
+    }
+    if (playerPowerUp[currentPlayer - 1] != NONE && !powerUpConsumed) {
+        isPowerUpActive = true;
+        powerUpActivated = true;
+        powerUpConsumed = true;
+        if (config.verbose) {
+            std::cout << "Power-up activado: " << playerPowerUp[currentPlayer - 1] << "\n";
+        }
+    }
+}
+
+// Simular un tick
+// Qué sucede: Avanza balas y tanques, verifica si algún jugador se quedó sin tanques y atiende los eventos vencidos
+//             (reloj, power-ups y fin de turno).
+void GameState::simulateTick() {
+    PROFILE_SCOPE("simulate_tick");
+    ++matchTicks;
+
+    // Guardar las posiciones de este tick para interpolar el dibujo
+    for (Tank& tank : tanks) {
+        tank.storePreviousPosition();
+    }
+
+    // Actualizar las balas
+    // Qué sucede: Mueve las balas y verifica si impactan un tanque o el borde del mapa.
+    {
+        PROFILE_SCOPE("bullets");
+        bullets.update(map, occupancy, tanks);
+    }
+
+    // Remover tanques destruidos del vector de tanques
+    // Qué sucede: Antes de borrarlos se liberan sus celdas en la capa de ocupación.
+    {
+        PROFILE_SCOPE("remove_destroyed");
+        for (Tank& tank : tanks) {
+            if (tank.isDestroyed()) {
+                tank.detachOccupancy();
+            }
+        }
+        tanks.erase(std::remove_if(tanks.begin(), tanks.end(),
+            [](const Tank& tank) { return tank.isDestroyed(); }), tanks.end());
+    }
+
+    // Mover el tanque seleccionado según la ruta calculada (una celda por tick)
+    Tank* tank = selectedTank();
+    if (!currentPath.empty() && tank != nullptr) {
+        Cell nextMove = currentPath.front();
+        currentPath.erase(currentPath.begin());
+        tank->setPosition(nextMove.x, nextMove.y);
+    }
+
+    // Verificar si un jugador ha eliminado todos los tanques del oponente
+    if (countAliveTanks(1) == 0 || countAliveTanks(2) == 0) {
+        finishMatch();
+        return;
+    }
+
+    // Atender los eventos vencidos en este tick
+    PROFILE_SCOPE("scheduled_events");
+    ScheduledEvent event;
+    while (!gameOver && events.popDue(matchTicks, event)) {
+        handleEvent(event);
+    }
+
+    // Turnos adicionales por power-up de doble turno
+    if (!gameOver && turnControl[currentPlayer - 1] > 0) {
+        endTurn();
+    }
+}
+
+// Atender un evento programado
+// Qué sucede: Cada evento vuelve a programar el siguiente de su tipo, así que siempre hay uno pendiente de cada uno.
+void GameState::handleEvent(const ScheduledEvent& event) {
+    switch (event.type) {
+        case EVENT_CLOCK:
+            // Verificar si el tiempo se ha terminado
+            remainingSeconds = remainingSecondsAt(matchTicks);
+            if (remainingSeconds <= 0) {
+                finishMatch();
+            } else {
+                scheduleClock();
+            }
+            break;
+
+        case EVENT_POWER_UP:
+            // Lógica para asignar power-ups aleatoriamente
+            // Qué sucede: Cada `powerUpSeconds` hay una probabilidad de `powerUpChance`% de recibir un power-up.
+            // Por qué sucede: Añade un elemento de sorpresa y estrategia al juego. Antes se sorteaba en cada frame, así
+            //                 que la frecuencia dependía de los FPS.
+            // Qué deberíamos esperar: Una vez activado un power-up no hay más sorteos, igual que antes.
+            if (!isPowerUpActive) {
+                if (rng.chance(config.powerUpChance)) {
+                    playerPowerUp[currentPlayer - 1] = static_cast<PowerUp>(rng.range(1, 4));
+                }
+                events.schedule(matchTicks + powerUpTicks, EVENT_POWER_UP);
+            }
+            break;
+
+        case EVENT_TURN_END:
+            // Cambiar de turno cada `turnSeconds`; los fines de turno de turnos ya terminados se descartan
+            if (event.payload == turnNumber) {
+                endTurn();
+            }
+            break;
+    }
+}
+
+// Terminar la partida
+// Qué sucede: Gana el jugador con más tanques vivos; con la misma cantidad es empate.
+void GameState::finishMatch() {
+    int player1TanksAlive = countAliveTanks(1);
+    int player2TanksAlive = countAliveTanks(2);
+    if (player1TanksAlive > player2TanksAlive) {
+        winner = 1;
+    } else if (player2TanksAlive > player1TanksAlive) {
+        winner = 2;
+    } else {
+        winner = 0;
+    }
+    gameOver = true;
+}
+
+// Terminar el turno actual
+// Qué sucede: Pasa el turno (o consume un turno adicional) y reinicia la selección, el poder usado y las balas.
+void GameState::endTurn() {
+    if (turnControl[currentPlayer - 1] > 0) {
+        turnControl[currentPlayer - 1]--;  // Reducir turnos adicionales si existen
+    } else {
+        currentPlayer = (currentPlayer == 1) ? 2 : 1;  // Cambiar al otro jugador
+    }
+
+    // Programar el fin del turno que empieza
+    ++turnNumber;
+    events.schedule(matchTicks + turnLengthTicks, EVENT_TURN_END, turnNumber);
+
+    powerUsed = false;
+    selectedPower = '\0';
+    selectedTankId = -1;
+    waitingForBFSClick = false;
+    waitingForAStarClick = false;
+    shootingMode = false;
+    currentPath.clear();
+    hasShot = false;
+    powerUpActivated = false;  // Reiniciar el estado de power-up
+    powerUpConsumed = false;
+
+    // Limpiar las balas activas al final del turno
+    bullets.clear();
+}
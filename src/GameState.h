@@ -0,0 +1,178 @@
+#ifndef GAME_STATE_H
+#define GAME_STATE_H
+
+#include "Map.h"
+#include "OccupancyGrid.h"
+#include "Tank.h"
+#include "Pathfinding.h"
+#include "PathCache.h"
+#include "BulletSystem.h"
+#include "Rng.h"
+#include "EventScheduler.h"
+#include "MapGenerator.h"
+#include <vector>
+#include <cstdint>
+#include <string>
+
+// Enumeración de los power-ups
+// Qué sucede: Se definen los diferentes tipos de power-ups disponibles en el juego.
+// Por qué sucede: Para permitir efectos especiales que los jugadores puedan utilizar durante el juego.
+enum PowerUp {
+    NONE,
+    DOUBLE_TURN,
+    MOVE_PRECISION,
+    ATTACK_PRECISION,
+    ATTACK_POWER
+};
+
+// Tipos de entrada que acepta la simulación
+// Qué sucede: Equivalen a las acciones de la ventana: clic en una celda y las teclas M, D y P.
+enum InputType {
+    INPUT_CLICK,  // Clic izquierdo en la celda `(x, y)`
+    INPUT_MOVE,  // Tecla M: mover el tanque seleccionado
+    INPUT_SHOOT,  // Tecla D: activar el modo disparo
+    INPUT_POWER_UP  // Tecla P: activar el power-up
+};
+
+// Entrada de un jugador para un tick
+// Qué sucede: `x` e `y` son coordenadas de celda (no píxeles) y solo se usan en `INPUT_CLICK`.
+struct GameInput {
+    InputType type;
+    int x = 0;
+    int y = 0;
+};
+
+// Parámetros de una partida
+struct GameConfig {
+    int mapSize = 20;  // Tamaño del mapa (20x20)
+    int obstaclePercentage = 10;  // Porcentaje de obstáculos
+    GeneratorStrategy mapStrategy = GENERATOR_NOISE;  // Estrategia de `MapGenerator` para el mapa generado
+    int terrainPercentage = 15;  // Barro y escombros del mapa generado (`GeneratorConfig::terrainPercentage`)
+    double tickSeconds = 1.0 / 60.0;  // Duración de un tick de simulación
+    double matchSeconds = 300.0;  // Duración máxima de la partida
+    double turnSeconds = 15.0;  // Duración de cada turno
+    double powerUpSeconds = 1.0;  // Intervalo entre sorteos de power-up
+    int powerUpChance = 30;  // Probabilidad (en %) de recibir un power-up en cada sorteo
+    bool verbose = true;  // Escribir en consola los eventos de la partida
+    std::uint64_t seed = 0;  // Semilla del generador de la partida (mapa, posiciones iniciales, power-ups)
+    std::string mapPath;  // Archivo de mapa (`tankattack-mapgen`); si no está vacío reemplaza al mapa generado
+    std::shared_ptr<const MapFile> mapFile;  // `mapPath` ya abierto (opcional): las partidas que lo comparten no lo
+                                             // vuelven a abrir ni a validar
+};
+
+// Estado completo de una partida, sin dependencias de SFML
+// Qué sucede: Reúne el mapa, los tanques, las balas, el generador aleatorio y todas las banderas de turno, selección
+//             y power-ups que antes eran variables locales de `main()` o globales. `step` aplica las entradas del tick y avanza la simulación un tick.
+// Por qué sucede: La lógica del juego se puede correr sin ventana (por ejemplo, para evaluar IAs a miles de ticks por
+//                 segundo) y el dibujo queda en `Renderer`.
+// Qué deberíamos esperar: Con las mismas entradas, `step` produce la misma partida en modo con ventana o sin ella.
+class GameState {
+public:
+    static constexpr int MIN_MAP_SIZE = 3;  // Lado mínimo del mapa: con 2x2 no caben los 8 tanques
+    // Límites de las duraciones de `GameConfig`: así `matchSeconds / tickSeconds` y los relojes caben en `int`.
+    static constexpr double MIN_TICK_SECONDS = 1e-4;
+    static constexpr double MAX_TICK_SECONDS = 1.0;
+    static constexpr double MAX_DURATION_SECONDS = 24.0 * 60.0 * 60.0;  // Partida, turno e intervalo de power-ups
+
+    // Constructor
+    // Qué sucede: Crea el mapa con obstáculos (o lo carga de `mapPath`), la capa de ocupación y los 8 tanques en
+    //             posiciones aleatorias de la zona libre principal. Con un archivo de mapa, `getConfig().mapSize` es
+    //             el tamaño del archivo. Un archivo más chico que `MIN_MAP_SIZE` se descarta y un `mapSize` más chico se
+    //             sube a `MIN_MAP_SIZE`.
+    explicit GameState(const GameConfig& config = GameConfig());
+
+    // Los tanques guardan un puntero a la capa de ocupación de esta partida, así que no se copia.
+    GameState(const GameState&) = delete;
+    GameState& operator=(const GameState&) = delete;
+
+    // Avanzar un tick
+    // Qué sucede: Aplica las entradas en orden y luego simula: balas, tanques destruidos, movimiento por la ruta,
+    //             condición de victoria y cambio de turno.
+    // Qué deberíamos esperar: Después de que termina la partida, `step` no hace nada.
+    void step(const std::vector<GameInput>& inputs);
+
+    bool isGameOver() const { return gameOver; }
+
+    // Ganador de la partida: 1 o 2, o 0 si fue empate (solo tiene sentido con `isGameOver`).
+    int getWinner() const { return winner; }
+
+    // Contar los tanques vivos de un jugador (1 o 2).
+    int countAliveTanks(int player) const;
+
+    // Verificar si un tanque pertenece a un jugador (1: azul y rojo, 2: celeste y amarillo).
+    static bool belongsToPlayer(const Tank& tank, int player);
+
+    const GameConfig& getConfig() const { return config; }
+    const Map& getMap() const { return map; }
+    const OccupancyGrid& getOccupancy() const { return occupancy; }
+    const std::vector<Tank>& getTanks() const { return tanks; }
+    const BulletSystem& getBullets() const { return bullets; }
+    const std::vector<Cell>& getCurrentPath() const { return currentPath; }
+    int getCurrentPlayer() const { return currentPlayer; }
+    PowerUp getPowerUp(int player) const { return playerPowerUp[player - 1]; }
+    std::uint64_t getTick() const { return matchTicks; }
+    int getRemainingSeconds() const { return remainingSeconds; }
+
+    // Estado del turno actual (útil para IAs)
+    const Tank* getSelectedTank() const;
+    bool isPowerUsed() const { return powerUsed; }
+    bool isShootingMode() const { return shootingMode; }
+    bool hasShotThisTurn() const { return hasShot; }
+    bool isWaitingForDestination() const { return waitingForBFSClick || waitingForAStarClick; }
+
+private:
+    GameConfig config;
+    Rng rng;  // Generador propio de la partida; no se comparte entre partidas ni hilos
+    Map map;
+    OccupancyGrid occupancy;
+    PathCache pathCache;  // Caché de rutas delante de BFS y A*
+    std::vector<Tank> tanks;
+    BulletSystem bullets;  // Balas activas en el juego (arreglos contiguos con huecos reutilizables)
+
+    // Variables de control del turno
+    int currentPlayer;  // Jugador actual (1 o 2)
+    int selectedTankId;  // ID del tanque seleccionado, -1 si no hay ninguno
+    bool waitingForBFSClick;  // Esperando un clic para el movimiento con BFS
+    bool waitingForAStarClick;  // Esperando un clic para el movimiento con A* (menor costo de terreno)
+    bool powerUsed;  // El jugador ya usó un poder en este turno
+    char selectedPower;  // Poder seleccionado ('M', 'D'), `\0` si no se ha seleccionado ninguno
+    std::vector<Cell> currentPath;  // Ruta calculada del tanque seleccionado
+    bool shootingMode;  // El modo disparo está activado
+    bool hasShot;  // El tanque ya disparó en el turno actual
+
+    // Variables para el sistema de power-ups
+    PowerUp playerPowerUp[2];  // Power-ups asignados a cada jugador
+    bool isPowerUpActive;  // Un power-up está activo
+    bool powerUpActivated;  // Un power-up fue activado en el turno actual
+    bool powerUpConsumed;  // El power-up fue consumido
+    int turnControl[2];  // Turnos adicionales por power-up de doble turno de cada jugador
+
+    // Temporizadores en ticks
+    // Qué sucede: El fin de turno, los sorteos de power-up y los cambios del reloj son eventos de `events`; un tick
+    //             sin eventos vencidos no revisa ningún temporizador.
+    std::uint64_t matchTicks;  // Ticks desde el inicio de la partida
+    std::uint64_t turnLengthTicks;  // Ticks que dura un turno
+    std::uint64_t powerUpTicks;  // Ticks entre sorteos de power-up
+    std::uint64_t turnNumber;  // Turnos terminados; descarta fines de turno programados por turnos anteriores
+    int remainingSeconds;  // Segundos enteros que quedan de partida (lo que muestra el reloj)
+    EventScheduler events;
+    bool gameOver;
+    int winner;
+
+    void placeTanks(Tank::Color color, int count, int firstId, int minX, int maxX, const std::vector<int>& cells);
+    Tank* selectedTank();
+    void handleClick(int x, int y);
+    bool isReachableDestination(const Tank& tank, int x, int y) const;
+    void handleMoveKey();
+    void handleShootKey();
+    void handlePowerUpKey();
+    void simulateTick();
+    void handleEvent(const ScheduledEvent& event);
+    void scheduleClock();
+    int remainingSecondsAt(std::uint64_t tick) const;
+    std::uint64_t secondsToTicks(double seconds) const;
+    void finishMatch();
+    void endTurn();
+};
+
+#endif
@@ -0,0 +1,129 @@
+#include "GridRaycast.h"
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// Recorrido de celdas de Amanatides-Woo
+// Qué sucede: Avanza de celda en celda por el borde más cercano (X o Y) usando las distancias paramétricas
+//             `tMaxX`/`tMaxY` hasta el siguiente borde y `tDeltaX`/`tDeltaY` entre bordes.
+// Por qué sucede: Cada celda que toca el segmento se visita exactamente una vez, en orden, con aritmética constante
+//                 por paso; no depende de un tamaño de paso fijo.
+// Qué deberíamos esperar: La primera celda donde `blocked(x, y)` devuelve un ID distinto de -2 (ver abajo) o que
+//                         está fuera del mapa. `blocked` devuelve -2 si la celda es libre, -1 si es terreno y el ID
+//                         del tanque si hay un tanque.
+template <typename Blocked>
+RayHit traverse(int mapSize, float startX, float startY, float dx, float dy, Blocked blocked) {
+    const float infinity = std::numeric_limits<float>::infinity();
+    RayHit result;
+
+    int cellX = static_cast<int>(std::floor(startX));
+    int cellY = static_cast<int>(std::floor(startY));
+
+    int stepX = (dx > 0) ? 1 : (dx < 0 ? -1 : 0);
+    int stepY = (dy > 0) ? 1 : (dy < 0 ? -1 : 0);
+
+    // Parámetro t (fracción del desplazamiento) en el que se cruza el siguiente borde vertical/horizontal
+    float tMaxX = (stepX > 0) ? (cellX + 1 - startX) / dx : (stepX < 0 ? (startX - cellX) / -dx : infinity);
+    float tMaxY = (stepY > 0) ? (cellY + 1 - startY) / dy : (stepY < 0 ? (startY - cellY) / -dy : infinity);
+    float tDeltaX = (stepX != 0) ? 1.0f / std::abs(dx) : infinity;
+    float tDeltaY = (stepY != 0) ? 1.0f / std::abs(dy) : infinity;
+
+    while (true) {
+        float t;
+        RayFace face;
+        if (tMaxX < tMaxY) {
+            t = tMaxX;
+            if (t > 1.0f) {
+                break;
+            }
+            cellX += stepX;
+            tMaxX += tDeltaX;
+            face = (stepX > 0) ? FACE_LEFT : FACE_RIGHT;
+        } else {
+            t = tMaxY;
+            if (t > 1.0f) {
+                break;
+            }
+            cellY += stepY;
+            tMaxY += tDeltaY;
+            face = (stepY > 0) ? FACE_TOP : FACE_BOTTOM;
+        }
+
+        int blocker = -1;  // El borde del mapa se comporta como terreno
+        bool inside = cellX >= 0 && cellX < mapSize && cellY >= 0 && cellY < mapSize;
+        if (inside) {
+            blocker = blocked(cellX, cellY);
+        }
+        if (blocker != -2) {
+            result.hit = true;
+            result.cellX = cellX;
+            result.cellY = cellY;
+            result.face = face;
+            result.fraction = t;
+            result.tankId = (blocker >= 0) ? blocker : OccupancyGrid::EMPTY;
+            return result;
+        }
+    }
+
+    return result;
+}
+
+}  // namespace
+
+RayHit castRay(const Map& map, float startX, float startY, float dx, float dy) {
+    return traverse(map.getSize(), startX, startY, dx, dy, [&map](int x, int y) {
+        return map.isObstacle(x, y) ? -1 : -2;
+    });
+}
+
+RayHit castRay(const Map& map, const OccupancyGrid& occupancy, int ignoreTankId,
+               float startX, float startY, float dx, float dy) {
+    return traverse(map.getSize(), startX, startY, dx, dy, [&map, &occupancy, ignoreTankId](int x, int y) {
+        if (map.isObstacle(x, y)) {
+            return -1;
+        }
+        int tankId = occupancy.tankAt(x, y);
+        return (tankId != OccupancyGrid::EMPTY && tankId != ignoreTankId) ? tankId : -2;
+    });
+}
+
+// Lanzar muchos rayos a la vez
+// Qué sucede: `hits` se redimensiona una sola vez y se llena en el orden de las consultas.
+void castRays(const Map& map, const OccupancyGrid& occupancy, const std::vector<RayQuery>& queries,
+              std::vector<RayHit>& hits) {
+    hits.resize(queries.size());
+    for (size_t i = 0; i < queries.size(); ++i) {
+        const RayQuery& query = queries[i];
+        hits[i] = castRay(map, occupancy, query.ignoreTankId, query.startX, query.startY, query.dx, query.dy);
+    }
+}
+
+void reflectDirection(const RayHit& hit, float& dirX, float& dirY) {
+    if (hit.face == FACE_LEFT || hit.face == FACE_RIGHT) {
+        dirX = -dirX;
+    } else if (hit.face == FACE_TOP || hit.face == FACE_BOTTOM) {
+        dirY = -dirY;
+    }
+}
+
+void contactPoint(const RayHit& hit, float startX, float startY, float dx, float dy, float& x, float& y) {
+    const float skin = 1e-3f;  // Separación de la cara para no quedar dentro de la celda bloqueante
+    x = startX + dx * hit.fraction;
+    y = startY + dy * hit.fraction;
+    switch (hit.face) {
+        case FACE_LEFT:   x = hit.cellX - skin;     break;
+        case FACE_RIGHT:  x = hit.cellX + 1 + skin; break;
+        case FACE_TOP:    y = hit.cellY - skin;     break;
+        case FACE_BOTTOM: y = hit.cellY + 1 + skin; break;
+        case FACE_NONE:   break;
+    }
+}
+
+// Verificar si la línea de vista está despejada
+// Qué sucede: Lanza un rayo de centro a centro; los tanques no bloquean la línea de vista.
+// Por qué sucede: Reemplaza el recorrido de pasos en punto flotante que podía saltear celdas en diagonal.
+bool isLineOfSightClear(int x1, int y1, int x2, int y2, const Map& map) {
+    RayHit hit = castRay(map, x1 + 0.5f, y1 + 0.5f, static_cast<float>(x2 - x1), static_cast<float>(y2 - y1));
+    return !hit.hit;
+}
@@ -0,0 +1,72 @@
+#ifndef GRID_RAYCAST_H
+#define GRID_RAYCAST_H
+
+#include "Map.h"
+#include "OccupancyGrid.h"
+#include <vector>
+
+// Cantidad máxima de rebotes que se resuelven en un solo desplazamiento
+// Qué sucede: Limita el trabajo por bala en una actualización (por ejemplo, atrapada en un rincón).
+constexpr int MAX_RAY_BOUNCES = 4;
+
+// Cara de la celda por la que entró un rayo
+// Qué sucede: Indica qué lado de la celda bloqueante cruzó el rayo; fuera del mapa el borde cuenta como pared.
+// Por qué sucede: Con la cara se obtiene la normal para reflejar la dirección en vez de girarla al azar.
+enum RayFace { FACE_NONE, FACE_LEFT, FACE_RIGHT, FACE_TOP, FACE_BOTTOM };
+
+// Resultado de lanzar un rayo
+// Qué sucede: Si `hit` es `true`, `(cellX, cellY)` es la primera celda bloqueante, `face` la cara por la que se
+//             entró y `fraction` la parte del desplazamiento recorrida hasta el contacto (entre 0 y 1).
+//             `tankId` es el tanque impactado, o `OccupancyGrid::EMPTY` si el rayo chocó contra terreno o el borde.
+struct RayHit {
+    bool hit = false;
+    int cellX = 0, cellY = 0;
+    RayFace face = FACE_NONE;
+    float fraction = 1.0f;
+    int tankId = OccupancyGrid::EMPTY;
+};
+
+// Consulta de un rayo para el lanzamiento por lotes
+// Qué sucede: Segmento de `(startX, startY)` a `(startX + dx, startY + dy)` en coordenadas de celda.
+//             Los tanques con ID `ignoreTankId` (el tirador) no bloquean el rayo.
+struct RayQuery {
+    float startX, startY;
+    float dx, dy;
+    int ignoreTankId = OccupancyGrid::EMPTY;
+};
+
+// Lanzar un rayo contra el terreno
+// Qué sucede: Recorre exactamente las celdas que cruza el segmento (Amanatides-Woo), sin saltear ninguna.
+// Por qué sucede: Avanzar en pasos de punto flotante y truncar podía saltear celdas y atravesar esquinas.
+// Qué deberíamos esperar: La primera celda con obstáculo (o el borde del mapa) dentro del desplazamiento.
+//                         La celda de inicio nunca bloquea, para que un rayo pueda salir de donde está.
+RayHit castRay(const Map& map, float startX, float startY, float dx, float dy);
+
+// Lanzar un rayo contra el terreno y los tanques
+// Qué sucede: Igual que el anterior, pero también se detiene en la primera celda ocupada por un tanque distinto de
+//             `ignoreTankId`.
+RayHit castRay(const Map& map, const OccupancyGrid& occupancy, int ignoreTankId,
+               float startX, float startY, float dx, float dy);
+
+// Lanzar muchos rayos a la vez
+// Qué sucede: Resuelve cada consulta en orden y deja los resultados en `hits` (mismo orden que `queries`).
+// Por qué sucede: El sistema de balas lanza un rayo por bala en cada actualización; los resultados se escriben en
+//                 un buffer reutilizable y cada consulta es independiente, así que el lote se puede repartir entre hilos.
+void castRays(const Map& map, const OccupancyGrid& occupancy, const std::vector<RayQuery>& queries,
+              std::vector<RayHit>& hits);
+
+// Reflejar una dirección según la cara impactada
+// Qué sucede: Invierte la componente X en las caras izquierda/derecha y la Y en las caras superior/inferior.
+void reflectDirection(const RayHit& hit, float& dirX, float& dirY);
+
+// Calcular el punto de contacto de un rayo
+// Qué sucede: Devuelve en `(x, y)` el punto donde el rayo tocó la cara impactada, corrido una distancia mínima
+//             hacia afuera para que quede dentro de la última celda libre. Sin impacto, es el final del segmento.
+void contactPoint(const RayHit& hit, float startX, float startY, float dx, float dy, float& x, float& y);
+
+// Verificar si la línea de vista entre dos celdas está despejada
+// Qué sucede: Lanza un rayo del centro de `(x1, y1)` al centro de `(x2, y2)` y revisa todas las celdas que cruza.
+// Qué deberíamos esperar: `true` si ninguna celda después del origen (incluido el destino) es un obstáculo.
+bool isLineOfSightClear(int x1, int y1, int x2, int y2, const Map& map);
+
+#endif
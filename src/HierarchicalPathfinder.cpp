@@ -0,0 +1,462 @@
+#include "HierarchicalPathfinder.h"
+#include "SearchWorkspace.h"
+#include <algorithm>
+#include <unordered_map>
+#include <cstdlib>
+
+// Desplazamientos de la BFS local, asociados a los bits de la máscara de vecinos
+struct LocalDirection {
+    int dx;
+    int dy;
+    std::uint8_t bit;
+};
+
+static const LocalDirection kLocalDirections[4] = {
+    {0, 1, Map::NEIGHBOR_DOWN},
+    {1, 0, Map::NEIGHBOR_RIGHT},
+    {0, -1, Map::NEIGHBOR_UP},
+    {-1, 0, Map::NEIGHBOR_LEFT}
+};
+
+// Las entradas de al menos este largo se representan con dos transiciones (una en cada extremo)
+static const int kLongEntrance = 6;
+
+// Constructor
+// Qué sucede: Guarda el tamaño de bloque; el grafo queda vacío hasta llamar a `build`.
+HierarchicalPathfinder::HierarchicalPathfinder(int clusterSize)
+    : clusterSize(clusterSize < 2 ? 2 : clusterSize), mapSize(0), clustersPerSide(0), mapVersion(0) {}
+
+// Construir el grafo abstracto completo
+// Qué sucede: Dimensiona los bloques y bordes, calcula todas las transiciones y luego el grafo interno de cada bloque.
+// Qué deberíamos esperar: O(celdas) para los bordes más una BFS local por entrada.
+void HierarchicalPathfinder::build(const Map& map) {
+    mapSize = map.getSize();
+    clustersPerSide = (mapSize + clusterSize - 1) / clusterSize;
+    int clusterCount = clustersPerSide * clustersPerSide;
+
+    clusters.assign(clusterCount, Cluster());
+    eastBorders.assign(clusterCount, {});
+    southBorders.assign(clusterCount, {});
+    dirty.assign(clusterCount, 0);
+    dirtyList.clear();
+    localDistance.assign(clusterSize * clusterSize, -1);
+    localParent.assign(clusterSize * clusterSize, -1);
+
+    for (int cy = 0; cy < clustersPerSide; ++cy) {
+        for (int cx = 0; cx < clustersPerSide; ++cx) {
+            computeEastBorder(map, cx, cy);
+            computeSouthBorder(map, cx, cy);
+        }
+    }
+    for (int cluster = 0; cluster < clusterCount; ++cluster) {
+        computeClusterGraph(map, cluster);
+    }
+
+    blocked.assign(map.getObstacleWords(), map.getObstacleWords() + map.getObstacleWordCount());
+    mapVersion = map.getVersion();
+}
+
+// Registrar el cambio de una celda
+// Qué sucede: Marca el bloque que contiene la celda; `update` recalcula sus bordes y el grafo de sus vecinos.
+void HierarchicalPathfinder::notifyCellChanged(int x, int y) {
+    if (clusters.empty() || x < 0 || x >= mapSize || y < 0 || y >= mapSize) {
+        return;
+    }
+    markDirty(clusterOf(x, y));
+}
+
+void HierarchicalPathfinder::markDirty(int cluster) {
+    if (!dirty[cluster]) {
+        dirty[cluster] = 1;
+        dirtyList.push_back(cluster);
+    }
+}
+
+// Reconstruir los bloques pendientes
+// Qué sucede: Primero marca los bloques de las celdas que el registro de cambios del mapa informa y cuyo bit de
+//             obstáculo difiere del que se usó para el grafo. Los bordes de un bloque cambiado se recalculan en sus
+//             4 lados; como eso cambia las entradas de los vecinos, también se recalcula el grafo interno de esos
+//             vecinos.
+// Por qué sucede: Un cambio de obstáculo no puede afectar a bloques más lejanos que los vecinos directos, y un cambio
+//                 de terreno no cambia el grafo (las distancias cuentan celdas).
+void HierarchicalPathfinder::update(const Map& map) {
+    if (clusters.empty() || mapSize != map.getSize()) {
+        build(map);
+        return;
+    }
+    if (mapVersion != map.getVersion()) {
+        changedCells.clear();
+        if (!map.changedCellsSince(mapVersion, changedCells)) {
+            build(map);
+            return;
+        }
+        for (int cell : changedCells) {
+            int x = cell % mapSize;
+            int y = cell / mapSize;
+            std::uint64_t bit = std::uint64_t(1) << (cell & 63);
+            if (map.isObstacle(x, y) != ((blocked[cell >> 6] & bit) != 0)) {
+                blocked[cell >> 6] ^= bit;
+                markDirty(clusterOf(x, y));
+            }
+        }
+        mapVersion = map.getVersion();
+    }
+    if (dirtyList.empty()) {
+        return;
+    }
+
+    std::vector<int> affected;
+    for (int cluster : dirtyList) {
+        int cx = cluster % clustersPerSide;
+        int cy = cluster / clustersPerSide;
+        computeEastBorder(map, cx, cy);
+        computeSouthBorder(map, cx, cy);
+        affected.push_back(cluster);
+        if (cx > 0) {
+            computeEastBorder(map, cx - 1, cy);
+            affected.push_back(cluster - 1);
+        }
+        if (cy > 0) {
+            computeSouthBorder(map, cx, cy - 1);
+            affected.push_back(cluster - clustersPerSide);
+        }
+        if (cx + 1 < clustersPerSide) affected.push_back(cluster + 1);
+        if (cy + 1 < clustersPerSide) affected.push_back(cluster + clustersPerSide);
+        dirty[cluster] = 0;
+    }
+    dirtyList.clear();
+
+    std::sort(affected.begin(), affected.end());
+    affected.erase(std::unique(affected.begin(), affected.end()), affected.end());
+    for (int cluster : affected) {
+        computeClusterGraph(map, cluster);
+    }
+
+    mapVersion = map.getVersion();
+}
+
+// Calcular las transiciones del borde derecho de un bloque
+// Qué sucede: Recorre la columna de frontera buscando tramos donde ambas celdas (a cada lado) están libres.
+//             Un tramo corto aporta una transición en su centro; uno largo, una en cada extremo.
+void HierarchicalPathfinder::computeEastBorder(const Map& map, int cx, int cy) {
+    std::vector<Transition>& border = eastBorders[cy * clustersPerSide + cx];
+    border.clear();
+    if (cx + 1 >= clustersPerSide) {
+        return;
+    }
+
+    int xa = (cx + 1) * clusterSize - 1;
+    int xb = xa + 1;
+    int y0 = cy * clusterSize;
+    int y1 = std::min(y0 + clusterSize, mapSize);
+
+    int runStart = -1;
+    for (int y = y0; y <= y1; ++y) {
+        bool open = y < y1 && map.isValidPosition(xa, y) && map.isValidPosition(xb, y);
+        if (open && runStart == -1) {
+            runStart = y;
+        } else if (!open && runStart != -1) {
+            int runEnd = y - 1;
+            if (runEnd - runStart + 1 >= kLongEntrance) {
+                border.push_back({map.cellIndex(xa, runStart), map.cellIndex(xb, runStart)});
+                border.push_back({map.cellIndex(xa, runEnd), map.cellIndex(xb, runEnd)});
+            } else {
+                int mid = (runStart + runEnd) / 2;
+                border.push_back({map.cellIndex(xa, mid), map.cellIndex(xb, mid)});
+            }
+            runStart = -1;
+        }
+    }
+}
+
+// Calcular las transiciones del borde inferior de un bloque
+// Qué sucede: Igual que `computeEastBorder`, pero sobre la fila de frontera con el bloque de abajo.
+void HierarchicalPathfinder::computeSouthBorder(const Map& map, int cx, int cy) {
+    std::vector<Transition>& border = southBorders[cy * clustersPerSide + cx];
+    border.clear();
+    if (cy + 1 >= clustersPerSide) {
+        return;
+    }
+
+    int ya = (cy + 1) * clusterSize - 1;
+    int yb = ya + 1;
+    int x0 = cx * clusterSize;
+    int x1 = std::min(x0 + clusterSize, mapSize);
+
+    int runStart = -1;
+    for (int x = x0; x <= x1; ++x) {
+        bool open = x < x1 && map.isValidPosition(x, ya) && map.isValidPosition(x, yb);
+        if (open && runStart == -1) {
+            runStart = x;
+        } else if (!open && runStart != -1) {
+            int runEnd = x - 1;
+            if (runEnd - runStart + 1 >= kLongEntrance) {
+                border.push_back({map.cellIndex(runStart, ya), map.cellIndex(runStart, yb)});
+                border.push_back({map.cellIndex(runEnd, ya), map.cellIndex(runEnd, yb)});
+            } else {
+                int mid = (runStart + runEnd) / 2;
+                border.push_back({map.cellIndex(mid, ya), map.cellIndex(mid, yb)});
+            }
+            runStart = -1;
+        }
+    }
+}
+
+// Calcular el grafo interno de un bloque
+// Qué sucede: Reúne las entradas de sus 4 bordes (sin repetir celdas), guarda sus parejas al otro lado y calcula
+//             las distancias internas con una BFS local desde cada entrada.
+void HierarchicalPathfinder::computeClusterGraph(const Map& map, int clusterId) {
+    int cx = clusterId % clustersPerSide;
+    int cy = clusterId / clustersPerSide;
+
+    std::vector<std::pair<int, int>> links;  // (celda propia, celda pareja)
+    for (const Transition& t : eastBorders[clusterId]) links.push_back({t.from, t.to});
+    for (const Transition& t : southBorders[clusterId]) links.push_back({t.from, t.to});
+    if (cx > 0) {
+        for (const Transition& t : eastBorders[clusterId - 1]) links.push_back({t.to, t.from});
+    }
+    if (cy > 0) {
+        for (const Transition& t : southBorders[clusterId - clustersPerSide]) links.push_back({t.to, t.from});
+    }
+    std::sort(links.begin(), links.end());
+
+    Cluster& cluster = clusters[clusterId];
+    cluster.nodeCells.clear();
+    cluster.partners.clear();
+    for (const auto& link : links) {
+        if (cluster.nodeCells.empty() || cluster.nodeCells.back() != link.first) {
+            cluster.nodeCells.push_back(link.first);
+            cluster.partners.push_back({});
+        }
+        cluster.partners.back().push_back(link.second);
+    }
+
+    int n = static_cast<int>(cluster.nodeCells.size());
+    cluster.distances.assign(n * n, -1);
+    for (int i = 0; i < n; ++i) {
+        bfsInCluster(map, clusterId, cluster.nodeCells[i]);
+        for (int j = 0; j < n; ++j) {
+            cluster.distances[i * n + j] = localDistanceTo(clusterId, cluster.nodeCells[j]);
+        }
+    }
+}
+
+// Buscar el índice local de una entrada dentro de su bloque, o -1 si la celda no es entrada.
+int HierarchicalPathfinder::localNodeIndex(const Cluster& cluster, int cell) const {
+    auto found = std::lower_bound(cluster.nodeCells.begin(), cluster.nodeCells.end(), cell);
+    if (found == cluster.nodeCells.end() || *found != cell) {
+        return -1;
+    }
+    return static_cast<int>(found - cluster.nodeCells.begin());
+}
+
+// BFS limitada a un bloque
+// Qué sucede: Calcula la distancia y el padre de cada celda del bloque desde `startCell`, sin salir de sus límites.
+// Por qué sucede: Sirve tanto para las distancias internas entre entradas como para refinar tramos de la ruta.
+void HierarchicalPathfinder::bfsInCluster(const Map& map, int clusterId, int startCell) {
+    int x0 = (clusterId % clustersPerSide) * clusterSize;
+    int y0 = (clusterId / clustersPerSide) * clusterSize;
+    int x1 = std::min(x0 + clusterSize, mapSize);
+    int y1 = std::min(y0 + clusterSize, mapSize);
+
+    std::fill(localDistance.begin(), localDistance.end(), -1);
+    localQueue.clear();
+
+    int sx = startCell % mapSize;
+    int sy = startCell / mapSize;
+    int startLocal = (sy - y0) * clusterSize + (sx - x0);
+    localDistance[startLocal] = 0;
+    localParent[startLocal] = -1;
+    localQueue.push_back(startLocal);
+
+    for (size_t head = 0; head < localQueue.size(); ++head) {
+        int current = localQueue[head];
+        int x = x0 + current % clusterSize;
+        int y = y0 + current / clusterSize;
+        std::uint8_t mask = map.getNeighborMask(x, y);
+        for (const LocalDirection& dir : kLocalDirections) {
+            int nx = x + dir.dx;
+            int ny = y + dir.dy;
+            if (!(mask & dir.bit) || nx < x0 || nx >= x1 || ny < y0 || ny >= y1) {
+                continue;
+            }
+            int next = current + dir.dy * clusterSize + dir.dx;
+            if (localDistance[next] == -1) {
+                localDistance[next] = localDistance[current] + 1;
+                localParent[next] = current;
+                localQueue.push_back(next);
+            }
+        }
+    }
+}
+
+// Distancia de la última BFS local hasta una celda del mismo bloque (-1 si no se alcanzó)
+int HierarchicalPathfinder::localDistanceTo(int clusterId, int cell) const {
+    int x0 = (clusterId % clustersPerSide) * clusterSize;
+    int y0 = (clusterId / clustersPerSide) * clusterSize;
+    int x = cell % mapSize;
+    int y = cell / mapSize;
+    return localDistance[(y - y0) * clusterSize + (x - x0)];
+}
+
+// Refinar un tramo dentro de un bloque
+// Qué sucede: BFS local desde `fromCell` y se agregan a `path` las celdas hasta `toCell` (sin repetir `fromCell`).
+void HierarchicalPathfinder::appendClusterPath(const Map& map, int clusterId, int fromCell, int toCell,
+                                               std::vector<Cell>& path) {
+    bfsInCluster(map, clusterId, fromCell);
+
+    int x0 = (clusterId % clustersPerSide) * clusterSize;
+    int y0 = (clusterId / clustersPerSide) * clusterSize;
+    int toLocal = (toCell / mapSize - y0) * clusterSize + (toCell % mapSize - x0);
+
+    size_t insertAt = path.size();
+    // El padre de `fromCell` es -1, y `fromCell` ya está al final de la ruta
+    for (int at = toLocal; localParent[at] != -1; at = localParent[at]) {
+        path.push_back({x0 + at % clusterSize, y0 + at / clusterSize});
+    }
+    std::reverse(path.begin() + insertAt, path.end());
+}
+
+// Cantidad total de entradas del grafo abstracto
+int HierarchicalPathfinder::getNodeCount() const {
+    int count = 0;
+    for (const Cluster& cluster : clusters) {
+        count += static_cast<int>(cluster.nodeCells.size());
+    }
+    return count;
+}
+
+// Buscar una ruta con HPA*
+// Qué sucede:
+//   1. Si inicio y destino están en el mismo bloque y hay camino dentro de él, se devuelve directamente.
+//   2. Se conectan inicio y destino con las entradas de sus bloques (BFS locales).
+//   3. A* con heurística Manhattan sobre las entradas; los nodos se identifican por su índice de celda.
+//   4. Cada tramo abstracto se refina a celdas: dentro de un bloque con BFS local, entre bloques es un paso.
+// Qué deberíamos esperar: La ruta celda por celda, o vacía si no hay ruta.
+std::vector<Cell> HierarchicalPathfinder::findPath(const Map& map, int startX, int startY, int endX, int endY) {
+    if (!map.isReachable(startX, startY, endX, endY)) {
+        return {};  // Obstáculo, fuera del mapa o en otra componente
+    }
+    update(map);
+
+    int startCell = map.cellIndex(startX, startY);
+    int goalCell = map.cellIndex(endX, endY);
+    int startCluster = clusterOf(startX, startY);
+    int goalCluster = clusterOf(endX, endY);
+
+    if (startCluster == goalCluster) {
+        bfsInCluster(map, startCluster, startCell);
+        if (localDistanceTo(startCluster, goalCell) != -1) {
+            std::vector<Cell> path = {{startX, startY}};
+            appendClusterPath(map, startCluster, startCell, goalCell, path);
+            return path;
+        }
+    }
+
+    // Conexiones del inicio con las entradas de su bloque
+    const Cluster& first = clusters[startCluster];
+    std::vector<int> startLinks(first.nodeCells.size());
+    bfsInCluster(map, startCluster, startCell);
+    for (size_t i = 0; i < first.nodeCells.size(); ++i) {
+        startLinks[i] = localDistanceTo(startCluster, first.nodeCells[i]);
+    }
+
+    // Conexiones de las entradas del bloque destino con el destino
+    const Cluster& last = clusters[goalCluster];
+    std::vector<int> goalLinks(last.nodeCells.size());
+    bfsInCluster(map, goalCluster, goalCell);
+    for (size_t i = 0; i < last.nodeCells.size(); ++i) {
+        goalLinks[i] = localDistanceTo(goalCluster, last.nodeCells[i]);
+    }
+
+    // A* sobre el grafo abstracto (pequeño, así que usa tablas hash)
+    std::vector<HeapEntry> open;
+    std::unordered_map<int, int> cost;
+    std::unordered_map<int, int> parent;
+    auto compare = [](const HeapEntry& a, const HeapEntry& b) {
+        if (a.f != b.f) return a.f > b.f;
+        return a.g < b.g;
+    };
+    auto heuristic = [&](int cell) {
+        return std::abs(cell % mapSize - endX) + std::abs(cell / mapSize - endY);
+    };
+    auto relax = [&](int from, int to, int newCost) {
+        auto found = cost.find(to);
+        if (found == cost.end() || newCost < found->second) {
+            cost[to] = newCost;
+            parent[to] = from;
+            open.push_back({newCost + heuristic(to), newCost, to});
+            std::push_heap(open.begin(), open.end(), compare);
+        }
+    };
+
+    cost[startCell] = 0;
+    parent[startCell] = -1;
+    open.push_back({heuristic(startCell), 0, startCell});
+
+    bool found = false;
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end(), compare);
+        HeapEntry current = open.back();
+        open.pop_back();
+        if (current.g > cost[current.index]) {
+            continue;
+        }
+        if (current.index == goalCell) {
+            found = true;
+            break;
+        }
+
+        if (current.index == startCell) {
+            for (size_t i = 0; i < startLinks.size(); ++i) {
+                if (startLinks[i] != -1) {
+                    relax(startCell, first.nodeCells[i], current.g + startLinks[i]);
+                }
+            }
+        }
+
+        int cluster = clusterOf(current.index % mapSize, current.index / mapSize);
+        const Cluster& data = clusters[cluster];
+        int local = localNodeIndex(data, current.index);
+        if (local == -1) {
+            continue;
+        }
+        int n = static_cast<int>(data.nodeCells.size());
+        for (int j = 0; j < n; ++j) {
+            int distance = data.distances[local * n + j];
+            if (j != local && distance != -1) {
+                relax(current.index, data.nodeCells[j], current.g + distance);
+            }
+        }
+        for (int partner : data.partners[local]) {
+            relax(current.index, partner, current.g + 1);
+        }
+        if (cluster == goalCluster && goalLinks[local] != -1) {
+            relax(current.index, goalCell, current.g + goalLinks[local]);
+        }
+    }
+
+    if (!found) {
+        return {};
+    }
+
+    // Recuperar la secuencia abstracta y refinarla tramo por tramo
+    std::vector<int> abstractPath;
+    for (int at = goalCell; at != -1; at = parent[at]) {
+        abstractPath.push_back(at);
+    }
+    std::reverse(abstractPath.begin(), abstractPath.end());
+
+    std::vector<Cell> path = {{startX, startY}};
+    for (size_t i = 1; i < abstractPath.size(); ++i) {
+        int from = abstractPath[i - 1];
+        int to = abstractPath[i];
+        int fromCluster = clusterOf(from % mapSize, from / mapSize);
+        if (fromCluster == clusterOf(to % mapSize, to / mapSize)) {
+            appendClusterPath(map, fromCluster, from, to, path);
+        } else {
+            path.push_back({to % mapSize, to / mapSize});
+        }
+    }
+    return path;
+}
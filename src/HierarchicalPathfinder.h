@@ -0,0 +1,95 @@
+#ifndef HIERARCHICAL_PATHFINDER_H
+#define HIERARCHICAL_PATHFINDER_H
+
+#include "Map.h"
+#include "Pathfinding.h"
+#include <vector>
+#include <cstdint>
+
+// Búsqueda jerárquica de rutas (HPA*) para mapas muy grandes
+// Qué sucede: Divide el mapa en bloques (clusters) de `clusterSize x clusterSize`, calcula las entradas entre bloques
+//             vecinos y las distancias entre entradas dentro de cada bloque. Las consultas largas se resuelven con A*
+//             sobre ese grafo abstracto y solo se refinan a celdas los tramos que forman la ruta.
+// Por qué sucede: Incluso con A*, una ruta larga en un mapa grande explora muchas celdas; el grafo abstracto tiene
+//                 unos pocos nodos por bloque.
+// Qué deberíamos esperar: Rutas casi óptimas (no siempre las más cortas) en formato `std::vector<Cell>`.
+//                         Solo se considera el terreno; quien mueve el tanque debe comprobar la ocupación.
+class HierarchicalPathfinder {
+public:
+    // Constructor
+    // Qué sucede: Define el tamaño de los bloques; el grafo se construye con `build`.
+    explicit HierarchicalPathfinder(int clusterSize = 16);
+
+    // Construir todo el grafo abstracto
+    // Qué sucede: Calcula las entradas de todos los bordes y las distancias internas de todos los bloques.
+    // Por qué sucede: Se llama después de `Map::generateObstacles` o cuando el mapa cambió por completo.
+    void build(const Map& map);
+
+    // Registrar el cambio de una celda
+    // Qué sucede: Marca como pendientes el bloque de la celda y, si está en un borde, el bloque vecino.
+    // Qué deberíamos esperar: Es opcional: `update` ya lee del registro de cambios del mapa las celdas modificadas.
+    void notifyCellChanged(int x, int y);
+
+    // Reconstruir los bloques pendientes
+    // Qué sucede: Pide al mapa las celdas cambiadas desde la última versión usada (`Map::changedCellsSince`) y marca
+    //             los bloques de las que cambiaron de obstáculo a libre o al revés; los cambios solo de terreno no
+    //             afectan al grafo y se ignoran. Después recalcula los bordes de los bloques marcados y las distancias
+    //             internas de esos bloques y sus vecinos. Si el registro ya no cubre esa versión (cambio masivo o
+    //             demasiados cambios) o cambió el tamaño, reconstruye todo.
+    void update(const Map& map);
+
+    // Buscar una ruta
+    // Qué sucede: Conecta inicio y destino al grafo abstracto, busca con A* y refina cada tramo dentro de su bloque.
+    // Qué deberíamos esperar: La ruta celda por celda (incluye inicio y destino), o vacía si no hay ruta.
+    std::vector<Cell> findPath(const Map& map, int startX, int startY, int endX, int endY);
+
+    int getClusterSize() const { return clusterSize; }
+
+    // Cantidad total de nodos abstractos (entradas) en el grafo.
+    int getNodeCount() const;
+
+private:
+    // Datos de un bloque
+    // Qué sucede: Guarda las celdas de entrada del bloque (ordenadas), sus celdas pareja al otro lado de cada borde
+    //             y la matriz de distancias internas entre entradas.
+    struct Cluster {
+        std::vector<int> nodeCells;  // Índice de celda de cada entrada, ordenado
+        std::vector<std::vector<int>> partners;  // Celdas del bloque vecino conectadas a cada entrada (costo 1)
+        std::vector<int> distances;  // Matriz `n x n` de distancias internas (-1 si no hay camino dentro del bloque)
+    };
+
+    // Par de celdas que cruza un borde entre dos bloques vecinos
+    struct Transition {
+        int from;  // Celda en el bloque izquierdo/superior
+        int to;  // Celda en el bloque derecho/inferior
+    };
+
+    int clusterSize;  // Lado de cada bloque en celdas
+    int mapSize;  // Tamaño del mapa usado al construir
+    int clustersPerSide;  // Cantidad de bloques por lado
+    std::uint64_t mapVersion;  // Versión del mapa al construir o actualizar
+    std::vector<Cluster> clusters;  // Bloques, fila por fila
+    std::vector<std::vector<Transition>> eastBorders;  // Transiciones entre (cx, cy) y (cx + 1, cy)
+    std::vector<std::vector<Transition>> southBorders;  // Transiciones entre (cx, cy) y (cx, cy + 1)
+    std::vector<std::uint8_t> dirty;  // Bloques pendientes de reconstruir
+    std::vector<int> dirtyList;  // Lista de bloques pendientes (sin repetidos)
+    std::vector<std::uint64_t> blocked;  // Obstáculos con los que está calculado el grafo (un bit por celda)
+    std::vector<int> changedCells;  // Búfer reutilizable para `Map::changedCellsSince`
+
+    // Buffers reutilizables de la BFS local
+    std::vector<int> localDistance;
+    std::vector<int> localParent;
+    std::vector<int> localQueue;
+
+    int clusterOf(int x, int y) const { return (y / clusterSize) * clustersPerSide + (x / clusterSize); }
+    void markDirty(int cluster);
+    void computeEastBorder(const Map& map, int cx, int cy);
+    void computeSouthBorder(const Map& map, int cx, int cy);
+    void computeClusterGraph(const Map& map, int cluster);
+    int localNodeIndex(const Cluster& cluster, int cell) const;
+    void bfsInCluster(const Map& map, int cluster, int startCell);
+    int localDistanceTo(int cluster, int cell) const;
+    void appendClusterPath(const Map& map, int cluster, int fromCell, int toCell, std::vector<Cell>& path);
+};
+
+#endif
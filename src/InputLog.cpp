@@ -0,0 +1,213 @@
+#include "InputLog.h"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+// Formato del archivo (versión 4)
+// Qué sucede: "TALG", versión, configuración, cantidad de entradas, entradas y resultado. Los enteros se guardan en
+//             LEB128 (7 bits por byte) y los `double` como sus 8 bytes en little-endian. La versión 2 agregó la ruta
+//             del archivo de mapa, la 3 la estrategia del generador y la 4 el porcentaje de terreno.
+// Por qué sucede: Desde la versión 4 el mapa tiene terreno y los tanques rojo/amarillo eligen rutas por su costo;
+//                 una partida de una versión anterior no se puede repetir con la misma semilla, así que esos
+//                 registros se rechazan.
+static const char kMagic[4] = {'T', 'A', 'L', 'G'};
+static const std::uint8_t kVersion = 4;
+static const std::uint8_t kOldestVersion = 4;
+
+static void writeVarint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(value) | 0x80);
+        value >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+static void writeDouble(std::vector<std::uint8_t>& out, double value) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    for (int i = 0; i < 8; ++i) {
+        out.push_back(static_cast<std::uint8_t>(bits >> (8 * i)));
+    }
+}
+
+// `true` si `low <= value <= high` (un NaN no pasa).
+static bool inRange(double value, double low, double high) {
+    return value >= low && value <= high;
+}
+
+// Lector del búfer con verificación de límites
+// Qué deberíamos esperar: Tras leer más allá del final, `ok` queda en `false` y los valores leídos son 0.
+struct ByteReader {
+    const std::vector<std::uint8_t>& data;
+    std::size_t at = 0;
+    bool ok = true;
+
+    std::uint8_t byte() {
+        if (at >= data.size()) {
+            ok = false;
+            return 0;
+        }
+        return data[at++];
+    }
+
+    std::uint64_t varint() {
+        std::uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            std::uint8_t b = byte();
+            value |= static_cast<std::uint64_t>(b & 0x7f) << shift;
+            if (!(b & 0x80)) {
+                return value;
+            }
+        }
+        ok = false;
+        return 0;
+    }
+
+    double real() {
+        std::uint64_t bits = 0;
+        for (int i = 0; i < 8; ++i) {
+            bits |= static_cast<std::uint64_t>(byte()) << (8 * i);
+        }
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+};
+
+InputLog::InputLog(const GameConfig& config) : config(config) {}
+
+void InputLog::record(std::uint64_t tick, const std::vector<GameInput>& inputs) {
+    for (const GameInput& input : inputs) {
+        entries.push_back({tick, input});
+    }
+}
+
+void InputLog::finish(std::uint64_t tick, int finalWinner) {
+    finished = true;
+    finalTick = tick;
+    winner = finalWinner;
+}
+
+void InputLog::inputsAt(std::uint64_t tick, std::vector<GameInput>& inputs) {
+    while (cursor < entries.size() && entries[cursor].tick < tick) {
+        ++cursor;
+    }
+    while (cursor < entries.size() && entries[cursor].tick == tick) {
+        inputs.push_back(entries[cursor++].input);
+    }
+}
+
+bool InputLog::save(const std::string& path) const {
+    std::vector<std::uint8_t> out(kMagic, kMagic + 4);
+    out.push_back(kVersion);
+    writeVarint(out, config.seed);
+    writeVarint(out, config.mapSize);
+    writeVarint(out, config.obstaclePercentage);
+    writeDouble(out, config.tickSeconds);
+    writeDouble(out, config.matchSeconds);
+    writeDouble(out, config.turnSeconds);
+    writeDouble(out, config.powerUpSeconds);
+    writeVarint(out, config.powerUpChance);
+    writeVarint(out, config.mapPath.size());
+    out.insert(out.end(), config.mapPath.begin(), config.mapPath.end());
+    writeVarint(out, config.mapStrategy);
+    writeVarint(out, config.terrainPercentage);
+
+    // Entradas: diferencia de tick, tipo y, para los clics, la celda
+    writeVarint(out, entries.size());
+    std::uint64_t previousTick = 0;
+    for (const Entry& entry : entries) {
+        writeVarint(out, entry.tick - previousTick);
+        previousTick = entry.tick;
+        out.push_back(static_cast<std::uint8_t>(entry.input.type));
+        if (entry.input.type == INPUT_CLICK) {
+            writeVarint(out, entry.input.x);
+            writeVarint(out, entry.input.y);
+        }
+    }
+
+    out.push_back(finished ? 1 : 0);
+    writeVarint(out, finalTick);
+    writeVarint(out, winner);
+
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(out.data()), out.size());
+    return static_cast<bool>(file);
+}
+
+bool InputLog::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::vector<std::uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (data.size() < 5 || std::memcmp(data.data(), kMagic, 4) != 0 || data[4] < kOldestVersion || data[4] > kVersion) {
+        return false;
+    }
+
+    ByteReader reader{data, 5};
+    GameConfig loaded;
+    loaded.seed = reader.varint();
+    std::uint64_t mapSize = reader.varint();
+    std::uint64_t obstaclePercentage = reader.varint();
+    loaded.tickSeconds = reader.real();
+    loaded.matchSeconds = reader.real();
+    loaded.turnSeconds = reader.real();
+    loaded.powerUpSeconds = reader.real();
+    loaded.powerUpChance = static_cast<int>(reader.varint());
+    std::uint64_t length = reader.varint();
+    for (std::uint64_t i = 0; i < length && reader.ok; ++i) {
+        loaded.mapPath.push_back(static_cast<char>(reader.byte()));
+    }
+    std::uint64_t strategy = reader.varint();
+    if (strategy > GENERATOR_ROOMS) {
+        return false;
+    }
+    loaded.mapStrategy = static_cast<GeneratorStrategy>(strategy);
+    std::uint64_t terrainPercentage = reader.varint();
+
+    std::uint64_t count = reader.varint();
+    std::vector<Entry> loadedEntries;
+    std::uint64_t tick = 0;
+    for (std::uint64_t i = 0; i < count && reader.ok; ++i) {
+        tick += reader.varint();
+        std::uint8_t type = reader.byte();
+        if (type > INPUT_POWER_UP) {
+            return false;
+        }
+        GameInput input{static_cast<InputType>(type)};
+        if (input.type == INPUT_CLICK) {
+            input.x = static_cast<int>(reader.varint());
+            input.y = static_cast<int>(reader.varint());
+        }
+        loadedEntries.push_back({tick, input});
+    }
+
+    bool loadedFinished = reader.byte() != 0;
+    std::uint64_t loadedFinalTick = reader.varint();
+    int loadedWinner = static_cast<int>(reader.varint());
+    // Validar la configuración antes de aceptarla
+    // Qué sucede: Los enteros se comparan antes de convertirlos a `int`, y las duraciones deben estar dentro de los
+    //             límites de `GameState` (un NaN tampoco pasa).
+    // Por qué sucede: Un log corrupto o malicioso podría pedir un mapa gigante, con índices que desbordan `int`, o
+    //                 porcentajes y duraciones que `GameState` no puede convertir a ticks ni a segundos enteros.
+    if (!reader.ok || mapSize < 2 || mapSize > static_cast<std::uint64_t>(Map::MAX_SIZE) || obstaclePercentage > 100 ||
+        terrainPercentage > 100 ||
+        !inRange(loaded.tickSeconds, GameState::MIN_TICK_SECONDS, GameState::MAX_TICK_SECONDS) ||
+        !inRange(loaded.matchSeconds, GameState::MIN_TICK_SECONDS, GameState::MAX_DURATION_SECONDS) ||
+        !inRange(loaded.turnSeconds, GameState::MIN_TICK_SECONDS, GameState::MAX_DURATION_SECONDS) ||
+        !inRange(loaded.powerUpSeconds, GameState::MIN_TICK_SECONDS, GameState::MAX_DURATION_SECONDS)) {
+        return false;
+    }
+    loaded.mapSize = static_cast<int>(mapSize);
+    loaded.obstaclePercentage = static_cast<int>(obstaclePercentage);
+    loaded.terrainPercentage = static_cast<int>(terrainPercentage);
+
+    config = loaded;
+    entries.swap(loadedEntries);
+    cursor = 0;
+    finished = loadedFinished;
+    finalTick = loadedFinalTick;
+    winner = loadedWinner;
+    return true;
+}
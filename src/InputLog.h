@@ -0,0 +1,64 @@
+#ifndef INPUT_LOG_H
+#define INPUT_LOG_H
+
+#include "GameState.h"
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Registro de entradas de una partida
+// Qué sucede: Guarda la configuración (con la semilla) y cada entrada con el tick en el que se aplicó, y lo escribe en
+//             un archivo binario compacto: enteros de longitud variable y el tick de cada entrada como diferencia con
+//             la anterior.
+// Por qué sucede: `GameState` es determinista: con la misma configuración y las mismas entradas en los mismos ticks
+//                 se juega la misma partida, así que el registro basta para reproducir una partida que falló.
+// Qué deberíamos esperar: Una partida de 5 minutos ocupa unos pocos cientos de bytes. Al reproducirla, el tick final
+//                         y el ganador coinciden con los guardados.
+class InputLog {
+public:
+    InputLog() = default;
+    explicit InputLog(const GameConfig& config);
+
+    const GameConfig& getConfig() const { return config; }
+    std::size_t getInputCount() const { return entries.size(); }
+
+    // Anotar las entradas aplicadas en el tick `tick` (el valor de `GameState::getTick` antes de `step`).
+    void record(std::uint64_t tick, const std::vector<GameInput>& inputs);
+
+    // Anotar cómo terminó la partida
+    // Qué sucede: Sin `finish` (por ejemplo, si se cerró la ventana antes del final) el registro no tiene resultado.
+    void finish(std::uint64_t finalTick, int finalWinner);
+
+    bool hasResult() const { return finished; }
+    std::uint64_t getFinalTick() const { return finalTick; }
+    int getWinner() const { return winner; }
+
+    // Entradas de un tick para reproducir
+    // Qué sucede: Avanza un cursor interno y agrega a `inputs` las entradas anotadas en `tick`; los ticks deben
+    //             pedirse en orden creciente.
+    void inputsAt(std::uint64_t tick, std::vector<GameInput>& inputs);
+
+    // Volver el cursor de reproducción al principio.
+    void rewind() { cursor = 0; }
+
+    // Escribir o leer el archivo
+    // Qué deberíamos esperar: `load` devuelve `false` si el archivo no existe, está truncado o no es un registro.
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+
+private:
+    struct Entry {
+        std::uint64_t tick;
+        GameInput input;
+    };
+
+    GameConfig config;
+    std::vector<Entry> entries;
+    std::size_t cursor = 0;
+    bool finished = false;
+    std::uint64_t finalTick = 0;
+    int winner = 0;
+};
+
+#endif
@@ -1,27 +1,214 @@
 #include "Map.h"
-#include <cstdlib>
-#include <ctime>
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
 
 // Constructor del mapa
-// Qué sucede: Inicializa el mapa, la matriz de obstáculos y la matriz de adyacencia.
+// Qué sucede: Inicializa el mapa vacío (buffer de bits en cero) y calcula los vecinos de cada celda. Sin obstáculos
+//             todo el mapa es la componente 0, y todo el terreno es llano.
 // Por qué sucede: Se asegura de que el mapa comience vacío y que todas las celdas estén bien definidas.
 Map::Map(int size) 
-    : size(size), grid(size, std::vector<bool>(size, false)), adjacencyMatrix(size * size, std::vector<int>(size * size, 0)) {
-    std::srand(std::time(nullptr));
-    initializeAdjacencyMatrix();  // Inicializamos la matriz de adyacencia
+    : size(size), obstacles((static_cast<std::size_t>(size) * size + 63) / 64, 0), neighbors(static_cast<std::size_t>(size) * size, 0),
+      components(static_cast<std::size_t>(size) * size, 0), componentSizes(1, size * size),
+      terrain(static_cast<std::size_t>(size) * size, TERRAIN_PLAIN), minMoveCost(terrainCost(TERRAIN_PLAIN)),
+      version(ChangeJournal::newVersion()) {
+    attachData();
+    rebuildNeighbors();  // Calculamos el grafo implícito del mapa vacío
+}
+
+// Copiar un mapa
+// Qué sucede: Copia los vectores y vuelve a apuntar a los datos propios, o comparte el archivo proyectado.
+Map::Map(const Map& other)
+    : size(other.size), obstacles(other.obstacles), neighbors(other.neighbors), components(other.components),
+      componentSizes(other.componentSizes), terrain(other.terrain), minMoveCost(other.minMoveCost), file(other.file),
+      version(other.version), journal(other.journal) {
+    attachData();
+}
+
+Map& Map::operator=(const Map& other) {
+    if (this != &other) {
+        size = other.size;
+        obstacles = other.obstacles;
+        neighbors = other.neighbors;
+        components = other.components;
+        componentSizes = other.componentSizes;
+        terrain = other.terrain;
+        minMoveCost = other.minMoveCost;
+        file = other.file;
+        version = other.version;
+        journal = other.journal;
+        attachData();
+    }
+    return *this;
+}
+
+// Apuntar a los datos en uso
+// Qué sucede: Los obstáculos salen del archivo si hay uno; los vecinos, las componentes y el terreno, del archivo
+//             solo si no se calcularon aparte.
+void Map::attachData() {
+    obstacleData = file ? file->getObstacles() : obstacles.data();
+    neighborData = file && neighbors.empty() ? file->getNeighbors() : neighbors.data();
+    componentData = file && components.empty() ? file->getComponents() : components.data();
+    terrainData = file && terrain.empty() ? file->getTerrain() : terrain.data();
+}
+
+// Cargar un mapa desde un archivo
+// Qué sucede: Si el archivo trae las máscaras de vecinos, las componentes y el terreno se usan tal cual; si no, se
+//             calculan en memoria propia (sin sección de terreno, todo es llano).
+bool Map::load(const std::string& path) {
+    return load(MapFile::open(path));
+}
+
+bool Map::load(std::shared_ptr<const MapFile> mapped) {
+    if (!mapped) {
+        return false;
+    }
+
+    size = mapped->getSize();
+    file = mapped;
+    obstacles.clear();
+    obstacles.shrink_to_fit();
+    neighbors.clear();
+    neighbors.shrink_to_fit();
+    components.clear();
+    components.shrink_to_fit();
+    componentSizes.clear();
+    terrain.clear();
+    terrain.shrink_to_fit();
+    if (file->getNeighbors() == nullptr) {
+        neighbors.assign(static_cast<std::size_t>(size) * size, 0);
+    }
+    if (file->getTerrain() == nullptr) {
+        terrain.assign(static_cast<std::size_t>(size) * size, TERRAIN_PLAIN);
+    }
+    attachData();
+    if (!neighbors.empty()) {
+        fillNeighborMasks();
+    }
+    if (file->getComponents() == nullptr) {
+        labelComponents();
+        attachData();
+    }
+    minMoveCost = terrain.empty() ? MIN_MOVE_COST : terrainCost(TERRAIN_PLAIN);
+    version = ChangeJournal::newVersion();
+    journal.reset(version);
+    return true;
+}
+
+// Copiar los datos del archivo a memoria propia
+// Qué sucede: La proyección es de solo lectura; antes del primer cambio se copian los obstáculos, los vecinos y el
+//             terreno. Las componentes se vuelven a etiquetar para tener también la cantidad de celdas de cada una.
+void Map::makeWritable() {
+    if (!file) {
+        return;
+    }
+    std::size_t cells = static_cast<std::size_t>(size) * size;
+    obstacles.assign(obstacleData, obstacleData + getObstacleWordCount());
+    if (neighbors.size() != cells) {
+        neighbors.assign(neighborData, neighborData + cells);
+    }
+    if (terrain.size() != cells) {
+        terrain.assign(terrainData, terrainData + cells);
+    }
+    file.reset();
+    attachData();
+    labelComponents();
+    updateMinMoveCost();
 }
 
 // Generar obstáculos en el mapa
-// Qué sucede: Genera obstáculos de manera aleatoria en la matriz `grid` según el porcentaje especificado.
+// Qué sucede: Genera obstáculos de manera aleatoria en el buffer de bits según el porcentaje especificado.
 // Por qué sucede: Los obstáculos crean desafíos adicionales en la navegación de los tanques.
-void Map::generateObstacles(int percentage) {
-    for (int i = 0; i < size; ++i) {
-        for (int j = 0; j < size; ++j) {
-            if (std::rand() % 100 < percentage) {
-                grid[i][j] = true; // Hay un obstáculo
+// Qué deberíamos esperar: Usa el generador de la partida, así que varios mapas se pueden generar en paralelo.
+void Map::generateObstacles(int percentage, Rng& rng) {
+    makeWritable();
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            if (rng.chance(percentage)) {
+                int index = cellIndex(x, y);
+                obstacles[index >> 6] |= std::uint64_t(1) << (index & 63); // Hay un obstáculo
             }
         }
     }
+    rebuildNeighbors();  // Los vecinos cambian con los nuevos obstáculos
+    labelComponents();
+    version = ChangeJournal::newVersion();
+    journal.reset(version);  // Cambio masivo: los datos derivados anteriores no pueden validarse celda por celda
+}
+
+// Reemplazar todos los obstáculos
+// Qué deberíamos esperar: Igual que `generateObstacles`, es un cambio masivo que reinicia el registro de cambios.
+void Map::assignObstacles(const std::vector<std::uint8_t>& cells, bool connected) {
+    makeWritable();
+    std::size_t count = static_cast<std::size_t>(size) * size;
+    for (std::size_t word = 0; word < obstacles.size(); ++word) {
+        std::uint64_t bits = 0;
+        std::size_t first = word * 64;
+        std::size_t last = std::min(first + 64, count);
+        for (std::size_t i = first; i < last; ++i) {
+            bits |= std::uint64_t(cells[i] != 0) << (i - first);
+        }
+        obstacles[word] = bits;
+    }
+    rebuildNeighbors();
+    if (connected) {
+        // Una sola componente: no hace falta recorrer los tramos, alcanza con marcar los obstáculos
+        components.resize(count);
+        std::int32_t* label = components.data();
+        const std::uint8_t* source = cells.data();
+        std::size_t blocked = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            std::int32_t obstacle = source[i] != 0;
+            label[i] = -obstacle;
+            blocked += static_cast<std::size_t>(obstacle);
+        }
+        componentSizes.assign(blocked < count ? 1 : 0, static_cast<std::int32_t>(count - blocked));
+        componentData = label;
+    } else {
+        labelComponents();
+    }
+    version = ChangeJournal::newVersion();
+    journal.reset(version);
+}
+
+// Reemplazar el terreno de todas las celdas
+void Map::assignTerrain(const std::vector<std::uint8_t>& types) {
+    makeWritable();
+    std::copy(types.begin(), types.begin() + terrain.size(), terrain.begin());
+    updateMinMoveCost();
+    version = ChangeJournal::newVersion();
+    journal.reset(version);
+}
+
+// Cambiar el terreno de una celda
+// Qué deberíamos esperar: Las cachés de rutas descartan las rutas que pasan por la celda, como con un obstáculo.
+void Map::setTerrain(int x, int y, TerrainType type) {
+    if (x < 0 || x >= size || y < 0 || y >= size || getTerrain(x, y) == type) {
+        return;
+    }
+    makeWritable();
+    int index = cellIndex(x, y);
+    terrain[index] = type;
+    minMoveCost = std::min(minMoveCost, terrainCost(type));
+    version = ChangeJournal::newVersion();
+    journal.record(version, index);
+}
+
+// Recalcular el menor costo de movimiento
+// Qué sucede: Marca qué tipos aparecen en el terreno y toma el más barato de ellos.
+void Map::updateMinMoveCost() {
+    bool present[TERRAIN_TYPES] = {};
+    const std::uint8_t* types = terrainData;
+    const std::size_t cells = static_cast<std::size_t>(size) * size;
+    for (std::size_t i = 0; i < cells; ++i) {
+        present[types[i] & (TERRAIN_TYPES - 1)] = true;  // Mismo recorte que `terrainCost`
+    }
+    minMoveCost = MAX_MOVE_COST;
+    for (int type = 0; type < TERRAIN_TYPES; ++type) {
+        if (present[type]) {
+            minMoveCost = std::min(minMoveCost, terrainCost(static_cast<TerrainType>(type)));
+        }
+    }
 }
 
 // Verificar si una celda tiene un obstáculo
@@ -31,29 +218,22 @@ bool Map::isObstacle(int x, int y) const {
     if (x < 0 || x >= size || y < 0 || y >= size) {
         return false;
     }
-    return grid[x][y];
+    return obstacleBit(cellIndex(x, y));
 }
 
 // Verificar si una posición es válida
 // Qué sucede: Verifica si la celda está dentro de los límites y no contiene un obstáculo.
 // Por qué sucede: Evita movimientos fuera de los límites o a celdas ocupadas por obstáculos.
 bool Map::isValidPosition(int x, int y) const {
-    return x >= 0 && x < size && y >= 0 && y < size && !grid[x][y];
+    return x >= 0 && x < size && y >= 0 && y < size && !obstacleBit(cellIndex(x, y));
 }
 
 // Verificar si una posición es válida y libre de obstáculos y tanques
 // Qué sucede: Verifica si la celda está dentro de los límites y no contiene un obstáculo o un tanque.
 // Por qué sucede: Permite garantizar que una celda esté completamente libre antes de mover un tanque.
-bool Map::isValidPosition(int x, int y, const std::vector<Tank>& tanks) const {
-    if (!isValidPosition(x, y)) {
-        return false;
-    }
-    for (const Tank& tank : tanks) {
-        if (tank.getX() == x && tank.getY() == y) {
-            return false; // Hay un tanque en la posición
-        }
-    }
-    return true;
+// Qué deberíamos esperar: Una consulta O(1) a la capa de ocupación en lugar de recorrer todos los tanques.
+bool Map::isValidPosition(int x, int y, const OccupancyGrid& occupancy) const {
+    return isValidPosition(x, y) && !occupancy.isOccupied(x, y);
 }
 
 // Obtener el tamaño del mapa
@@ -63,58 +243,464 @@ int Map::getSize() const {
     return size;
 }
 
-// Dibujar el mapa en la ventana
-// Qué sucede: Dibuja cada celda del mapa, diferenciando entre celdas libres y celdas con obstáculos.
-// Por qué sucede: Para proporcionar una representación visual del estado del mapa en el juego.
-void Map::draw(sf::RenderWindow& window, int cellSize) const {
-    sf::RectangleShape cellShape(sf::Vector2f(cellSize, cellSize));
-    cellShape.setFillColor(sf::Color::White);
-    cellShape.setOutlineThickness(1);
-    cellShape.setOutlineColor(sf::Color::Black);
-
-    for (int x = 0; x < size; ++x) {
-        for (int y = 0; y < size; ++y) {
-            cellShape.setPosition(x * cellSize, y * cellSize);
-            if (grid[x][y]) {
-                cellShape.setFillColor(sf::Color::Black);  // Representar obstáculos
+// Recalcular las máscaras de vecinos
+// Qué sucede: Para cada celda libre guarda en 4 bits qué vecinos son transitables; los obstáculos quedan en 0.
+// Por qué sucede: Reemplaza la matriz de adyacencia (size^4 enteros) por un byte por celda, lineal en el número de celdas.
+void Map::rebuildNeighbors() {
+    makeWritable();
+    fillNeighborMasks();
+}
+
+// Tabla para expandir 8 bits en 8 bytes: el bit `i` de `bits` pasa a ser el byte `i` (0 o 1) de `values[bits]`.
+struct SpreadTable {
+    std::uint64_t values[256];
+
+    SpreadTable() {
+        for (unsigned bits = 0; bits < 256; ++bits) {
+            values[bits] = 0;
+            for (int i = 0; i < 8; ++i) {
+                values[bits] |= std::uint64_t((bits >> i) & 1u) << (8 * i);
+            }
+        }
+    }
+};
+
+// Celdas libres de a 64 a partir del buffer de obstáculos
+// Qué sucede: `at(start)` devuelve una palabra cuyo bit `k` indica si la celda `start + k` está libre; las celdas
+//             fuera del mapa (también con `start` negativo) cuentan como ocupadas.
+struct FreeBits {
+    const std::uint64_t* bits;
+    std::ptrdiff_t words;
+    std::uint64_t lastMask;
+
+    FreeBits(const std::uint64_t* bits, std::ptrdiff_t cells)
+        : bits(bits), words((cells + 63) / 64),
+          lastMask(cells % 64 ? (std::uint64_t(1) << (cells % 64)) - 1 : ~std::uint64_t(0)) {}
+
+    std::uint64_t word(std::ptrdiff_t w) const {
+        if (w < 0 || w >= words) {
+            return 0;
+        }
+        return ~bits[w] & (w == words - 1 ? lastMask : ~std::uint64_t(0));
+    }
+
+    std::uint64_t at(std::ptrdiff_t start) const {
+        std::ptrdiff_t q = start >= 0 ? start / 64 : -((63 - start) / 64);
+        int r = static_cast<int>(start - q * 64);
+        std::uint64_t low = word(q) >> r;
+        return r ? low | word(q + 1) << (64 - r) : low;
+    }
+};
+
+// Máscara con los `count` bits bajos en 1 (todos si `count >= 64`)
+static std::uint64_t lowBits(std::ptrdiff_t count) {
+    return count < 64 ? (std::uint64_t(1) << count) - 1 : ~std::uint64_t(0);
+}
+
+// Calcular las máscaras de vecinos de un tramo del mapa
+// Qué sucede: Trabaja de a 64 celdas: toma la palabra de celdas libres y la misma palabra desplazada 1 celda
+//             (derecha e izquierda) y `size` celdas (abajo y arriba); cada vecino es un AND de palabras. Los bits se
+//             expanden a bytes de a 8 con una tabla, y al final se quitan los vecinos que cruzan el borde de una fila.
+//             Escribe en `out` las celdas de las palabras `[firstWord, endWord)`, empezando por la celda `firstWord * 64`.
+// Por qué sucede: Celda por celda eran 5 lecturas de bits y 4 condiciones impredecibles por celda; en un mapa de
+//                 4096x4096 esto dominaba el tiempo de generar o cargar.
+static void computeNeighborMasks(const std::uint64_t* bits, int size, std::ptrdiff_t firstWord, std::ptrdiff_t endWord,
+                                 std::uint8_t* out) {
+    static const SpreadTable table;  // Local: se inicializa una sola vez aunque varios hilos generen mapas
+    const std::uint64_t* spread = table.values;
+    const std::ptrdiff_t n = size;
+    const std::ptrdiff_t cells = n * n;
+    const std::ptrdiff_t base = firstWord * 64;
+    const std::ptrdiff_t end = std::min(cells, endWord * 64);
+
+    const FreeBits free(bits, cells);
+    for (std::ptrdiff_t w = firstWord; w < endWord; ++w) {
+        std::uint64_t self = free.word(w);
+        std::uint64_t right = free.at(w * 64 + 1) & self;
+        std::uint64_t left = free.at(w * 64 - 1) & self;
+        std::uint64_t down = free.at(w * 64 + n) & self;
+        std::uint64_t up = free.at(w * 64 - n) & self;
+        for (int chunk = 0; chunk < 8; ++chunk) {
+            std::ptrdiff_t first = w * 64 + chunk * 8;
+            if (first >= cells) {
+                break;
+            }
+            int shift = chunk * 8;
+            std::uint64_t masks = spread[(right >> shift) & 255] * Map::NEIGHBOR_RIGHT |
+                                  spread[(left >> shift) & 255] * Map::NEIGHBOR_LEFT |
+                                  spread[(down >> shift) & 255] * Map::NEIGHBOR_DOWN |
+                                  spread[(up >> shift) & 255] * Map::NEIGHBOR_UP;
+            std::ptrdiff_t count = std::min<std::ptrdiff_t>(8, cells - first);
+            for (std::ptrdiff_t i = 0; i < count; ++i) {
+                out[first - base + i] = static_cast<std::uint8_t>(masks >> (8 * i));
+            }
+        }
+    }
+
+    // Los desplazamientos de 1 celda pasan de una fila a la siguiente: el primero y el último de cada fila no lo son
+    for (std::ptrdiff_t y = base / n; y * n < end; ++y) {
+        if (y * n >= base) {
+            out[y * n - base] &= ~Map::NEIGHBOR_LEFT;
+        }
+        if (y * n + n - 1 < end) {
+            out[y * n + n - 1 - base] &= ~Map::NEIGHBOR_RIGHT;
+        }
+    }
+}
+
+// Calcular las máscaras de vecinos de todo el mapa
+void Map::fillNeighborMasks() {
+    computeNeighborMasks(obstacleData, size, 0, static_cast<std::ptrdiff_t>(getObstacleWordCount()), neighbors.data());
+}
+
+// Comparar máscaras de vecinos con las que corresponden a los obstáculos
+// Qué sucede: Las calcula de a tramos de 4096 celdas en un búfer local y compara cada tramo con `memcmp`.
+bool Map::neighborMasksMatch(const std::uint64_t* bits, int size, const std::uint8_t* masks) {
+    constexpr std::ptrdiff_t blockWords = 64;
+    std::uint8_t expected[blockWords * 64];
+    const std::ptrdiff_t cells = static_cast<std::ptrdiff_t>(size) * size;
+    const std::ptrdiff_t words = (cells + 63) / 64;
+    for (std::ptrdiff_t w = 0; w < words; w += blockWords) {
+        std::ptrdiff_t endWord = std::min(words, w + blockWords);
+        computeNeighborMasks(bits, size, w, endWord, expected);
+        std::ptrdiff_t count = std::min(cells, endWord * 64) - w * 64;
+        if (std::memcmp(expected, masks + w * 64, count) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Calcular la máscara de vecinos de una celda
+// Qué sucede: Revisa las 4 celdas adyacentes de una celda libre; los obstáculos no tienen vecinos.
+std::uint8_t Map::computeNeighborMask(int x, int y) const {
+    int index = cellIndex(x, y);
+    std::uint8_t mask = 0;
+    if (!obstacleBit(index)) {
+        // Verificar celdas adyacentes (derecha, izquierda, abajo, arriba)
+        if (x + 1 < size && !obstacleBit(index + 1)) mask |= NEIGHBOR_RIGHT;
+        if (x > 0 && !obstacleBit(index - 1)) mask |= NEIGHBOR_LEFT;
+        if (y + 1 < size && !obstacleBit(index + size)) mask |= NEIGHBOR_DOWN;
+        if (y > 0 && !obstacleBit(index - size)) mask |= NEIGHBOR_UP;
+    }
+    return mask;
+}
+
+// Cambiar el estado de obstáculo de una celda
+// Qué sucede: Modifica el bit de la celda y recalcula solo las máscaras afectadas (la celda y sus vecinas).
+// Por qué sucede: Un cambio local no debe costar un recorrido de todo el mapa.
+// Qué deberíamos esperar: La versión del mapa cambia, así que las estructuras derivadas detectan el cambio.
+void Map::setObstacle(int x, int y, bool obstacle) {
+    if (x < 0 || x >= size || y < 0 || y >= size || obstacleBit(cellIndex(x, y)) == obstacle) {
+        return;
+    }
+
+    makeWritable();
+    int index = cellIndex(x, y);
+    if (obstacle) {
+        obstacles[index >> 6] |= std::uint64_t(1) << (index & 63);
+    } else {
+        obstacles[index >> 6] &= ~(std::uint64_t(1) << (index & 63));
+    }
+
+    neighbors[index] = computeNeighborMask(x, y);
+    if (x + 1 < size) neighbors[index + 1] = computeNeighborMask(x + 1, y);
+    if (x > 0) neighbors[index - 1] = computeNeighborMask(x - 1, y);
+    if (y + 1 < size) neighbors[index + size] = computeNeighborMask(x, y + 1);
+    if (y > 0) neighbors[index - size] = computeNeighborMask(x, y - 1);
+
+    // Actualizar las componentes con las vecinas libres de la celda
+    std::vector<int> freeNeighbors;
+    if (x + 1 < size && !obstacleBit(index + 1)) freeNeighbors.push_back(index + 1);
+    if (x > 0 && !obstacleBit(index - 1)) freeNeighbors.push_back(index - 1);
+    if (y + 1 < size && !obstacleBit(index + size)) freeNeighbors.push_back(index + size);
+    if (y > 0 && !obstacleBit(index - size)) freeNeighbors.push_back(index - size);
+    if (obstacle) {
+        // Bloquear puede partir la componente en hasta 4 pedazos
+        std::int32_t label = components[index];
+        components[index] = -1;
+        --componentSizes[label];
+        if (freeNeighbors.size() > 1) {
+            splitComponent(label, freeNeighbors);
+        }
+    } else {
+        // Liberar une las componentes vecinas: se conserva la más grande y las demás se reetiquetan
+        std::int32_t target = -1;
+        for (int neighbor : freeNeighbors) {
+            std::int32_t label = components[neighbor];
+            if (target == -1 || componentSizes[label] > componentSizes[target]) {
+                target = label;
+            }
+        }
+        if (target == -1) {
+            target = static_cast<std::int32_t>(componentSizes.size());
+            componentSizes.push_back(0);
+        }
+        components[index] = target;
+        ++componentSizes[target];
+        for (int neighbor : freeNeighbors) {
+            std::int32_t label = components[neighbor];
+            if (label != target) {
+                componentSizes[target] += componentSizes[label];
+                componentSizes[label] = 0;
+                relabelComponent(neighbor, label, target);
+            }
+        }
+    }
+
+    version = ChangeJournal::newVersion();
+    journal.record(version, index);
+}
+
+// Componente conexa de una celda
+int Map::getComponent(int x, int y) const {
+    if (x < 0 || x >= size || y < 0 || y >= size) {
+        return -1;
+    }
+    return componentData[cellIndex(x, y)];
+}
+
+// Verificar si hay camino entre dos celdas
+bool Map::isReachable(int startX, int startY, int endX, int endY) const {
+    int component = getComponent(startX, startY);
+    return component != -1 && component == getComponent(endX, endY);
+}
+
+// Etiquetar las componentes conexas
+// Qué sucede: Recorre las filas por tramos de celdas libres seguidas, buscados de a 64 celdas en el buffer de bits,
+//             con un union-find guardado en el mismo arreglo `components`: cada celda apunta a la primera de su tramo
+//             y cada tramo se une con los tramos de la fila de arriba que toca. Como un padre siempre tiene un índice
+//             menor, una segunda pasada en orden da a cada raíz la siguiente etiqueta libre y a cada tramo la etiqueta
+//             de su padre, ya convertida.
+// Por qué sucede: Una búsqueda en anchura por componente visita cada celda con saltos por todo el arreglo; esto son
+//                 dos pasadas secuenciales que trabajan por tramo (no por celda) y no necesitan memoria aparte.
+// Qué deberíamos esperar: Etiquetas consecutivas desde 0, en orden de la primera celda de cada componente.
+void Map::labelComponents() {
+    const std::int32_t n = size;
+    const std::size_t cells = static_cast<std::size_t>(n) * n;
+    components.resize(cells);
+    std::int32_t* label = components.data();
+    const FreeBits free(obstacleData, static_cast<std::ptrdiff_t>(cells));
+    auto find = [label](std::int32_t cell) {
+        while (label[cell] != cell) {
+            label[cell] = label[label[cell]];
+            cell = label[cell];
+        }
+        return cell;
+    };
+
+    // Buscar en la fila `row` el próximo tramo libre [start, end) desde la columna `from` (`false` si no hay)
+    auto nextRun = [&free, n](std::int32_t row, std::int32_t from, std::int32_t& start, std::int32_t& end) {
+        start = from;
+        for (; start < n; start += 64) {
+            std::uint64_t open = free.at(row + start) & lowBits(n - start);
+            if (open) {
+                start += __builtin_ctzll(open);
+                break;
+            }
+        }
+        start = std::min(start, n);
+        for (end = start; end < n; end += 64) {
+            std::uint64_t blocked = ~free.at(row + end) & lowBits(n - end);
+            if (blocked) {
+                end += __builtin_ctzll(blocked);
+                break;
+            }
+        }
+        end = std::min(end, n);
+        return start < n;
+    };
+
+    for (std::int32_t y = 0; y < n; ++y) {
+        const std::int32_t row = y * n;
+        std::int32_t x = 0;
+        std::int32_t start;
+        std::int32_t end;
+        while (nextRun(row, x, start, end)) {
+            std::fill(label + row + x, label + row + start, -1);
+            std::fill(label + row + start, label + row + end, row + start);
+            // Unir con cada tramo libre de la fila de arriba que toca este
+            std::uint64_t carry = 0;
+            for (std::int32_t p = start; y > 0 && p < end; p += 64) {
+                std::uint64_t above = free.at(row - n + p) & lowBits(end - p);
+                std::uint64_t starts = above & ~(above << 1 | carry);
+                carry = above >> 63;
+                for (; starts; starts &= starts - 1) {
+                    std::int32_t a = find(row + start);
+                    std::int32_t b = find(row - n + p + __builtin_ctzll(starts));
+                    if (a < b) {
+                        label[b] = a;
+                    } else if (b < a) {
+                        label[a] = b;
+                    }
+                }
+            }
+            x = end;
+        }
+        std::fill(label + row + x, label + row + n, -1);
+    }
+
+    // El padre de la primera celda de un tramo ya tiene su etiqueta final; el resto del tramo la copia
+    componentSizes.clear();
+    for (std::int32_t y = 0; y < n; ++y) {
+        const std::int32_t row = y * n;
+        std::int32_t start;
+        std::int32_t end;
+        for (std::int32_t x = 0; nextRun(row, x, start, end); x = end) {
+            std::int32_t first = row + start;
+            std::int32_t component = label[first];
+            if (component == first) {
+                component = static_cast<std::int32_t>(componentSizes.size());
+                componentSizes.push_back(0);
             } else {
-                cellShape.setFillColor(sf::Color::White);
+                component = label[component];
             }
-            window.draw(cellShape);
+            std::fill(label + first, label + row + end, component);
+            componentSizes[component] += end - start;
         }
     }
+    componentData = components.data();
 }
 
-// Inicializar la matriz de adyacencia
-// Qué sucede: Establece las relaciones de adyacencia entre las celdas que no tienen obstáculos.
-// Por qué sucede: Permite modelar el mapa como un grafo que se utiliza para la búsqueda de rutas.
-void Map::initializeAdjacencyMatrix() {
-    for (int x = 0; x < size; ++x) {
-        for (int y = 0; y < size; ++y) {
-            int currentIndex = cellIndex(x, y);
-            if (!isObstacle(x, y)) {
-                // Verificar celdas adyacentes (arriba, abajo, izquierda, derecha)
-                if (isValidPosition(x + 1, y)) adjacencyMatrix[currentIndex][cellIndex(x + 1, y)] = 1;
-                if (isValidPosition(x - 1, y)) adjacencyMatrix[currentIndex][cellIndex(x - 1, y)] = 1;
-                if (isValidPosition(x, y + 1)) adjacencyMatrix[currentIndex][cellIndex(x, y + 1)] = 1;
-                if (isValidPosition(x, y - 1)) adjacencyMatrix[currentIndex][cellIndex(x, y - 1)] = 1;
+// Reetiquetar una componente
+// Qué sucede: Búsqueda en anchura desde `seed` por las celdas con etiqueta `from`.
+// Qué deberíamos esperar: Cuesta lo que mide la componente; `setObstacle` reetiqueta siempre la más chica.
+void Map::relabelComponent(int seed, std::int32_t from, std::int32_t to) {
+    std::vector<int> queue(1, seed);
+    components[seed] = to;
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        int index = queue[head];
+        std::uint8_t mask = neighbors[index];
+        int candidates[4] = {(mask & NEIGHBOR_RIGHT) ? index + 1 : -1, (mask & NEIGHBOR_LEFT) ? index - 1 : -1,
+                             (mask & NEIGHBOR_DOWN) ? index + size : -1, (mask & NEIGHBOR_UP) ? index - size : -1};
+        for (int next : candidates) {
+            if (next != -1 && components[next] == from) {
+                components[next] = to;
+                queue.push_back(next);
             }
         }
     }
 }
 
+// Separar una componente
+// Qué sucede: Las vecinas que siguen unidas por una esquina libre del anillo de 3x3 se agrupan sin buscar. Si queda
+//             más de un grupo, se hace una búsqueda en anchura por grupo, de a una celda por turno; cuando dos
+//             búsquedas se encuentran sus grupos se unen, y cuando todas las de un grupo se agotan, ese grupo es un
+//             pedazo cerrado y recibe una etiqueta nueva. Se termina cuando queda un solo grupo abierto, que conserva
+//             la etiqueta.
+// Por qué sucede: Al avanzar todas a la vez, el costo lo marcan los pedazos que se separan (los más chicos) y no la
+//                 componente completa.
+void Map::splitComponent(std::int32_t label, const std::vector<int>& seeds) {
+    const int count = static_cast<int>(seeds.size());
+    int group[4];
+    auto findGroup = [&group](int g) {
+        while (group[g] != g) {
+            g = group[g];
+        }
+        return g;
+    };
+    auto joinGroups = [&](int a, int b) {
+        a = findGroup(a);
+        b = findGroup(b);
+        group[std::max(a, b)] = std::min(a, b);
+    };
+    for (int i = 0; i < count; ++i) {
+        group[i] = i;
+    }
+
+    // Dos vecinas en diagonal comparten dos esquinas: una es la celda bloqueada y la otra las une si está libre
+    for (int i = 0; i < count; ++i) {
+        for (int j = i + 1; j < count; ++j) {
+            int ax = seeds[i] % size, ay = seeds[i] / size;
+            int bx = seeds[j] % size, by = seeds[j] / size;
+            if (ax != bx && ay != by && (!obstacleBit(cellIndex(ax, by)) || !obstacleBit(cellIndex(bx, ay)))) {
+                joinGroups(i, j);
+            }
+        }
+    }
+    int open = 0;
+    for (int i = 0; i < count; ++i) {
+        open += findGroup(i) == i ? 1 : 0;
+    }
+    if (open <= 1) {
+        return;
+    }
+
+    // Búsquedas simultáneas, una por vecina; `owner` guarda qué búsqueda visitó cada celda
+    std::vector<int> queues[4];
+    std::size_t heads[4] = {0, 0, 0, 0};
+    bool closed[4] = {false, false, false, false};
+    std::unordered_map<int, int> owner;
+    for (int i = 0; i < count; ++i) {
+        queues[i].push_back(seeds[i]);
+        owner[seeds[i]] = i;
+    }
+
+    while (open > 1) {
+        // Avanzar una celda en cada búsqueda con frontera
+        for (int i = 0; i < count; ++i) {
+            if (heads[i] == queues[i].size()) {
+                continue;
+            }
+            int index = queues[i][heads[i]++];
+            std::uint8_t mask = neighbors[index];
+            int candidates[4] = {(mask & NEIGHBOR_RIGHT) ? index + 1 : -1, (mask & NEIGHBOR_LEFT) ? index - 1 : -1,
+                                 (mask & NEIGHBOR_DOWN) ? index + size : -1, (mask & NEIGHBOR_UP) ? index - size : -1};
+            for (int next : candidates) {
+                if (next == -1) {
+                    continue;
+                }
+                auto found = owner.find(next);
+                if (found == owner.end()) {
+                    owner.emplace(next, i);
+                    queues[i].push_back(next);
+                } else if (findGroup(found->second) != findGroup(i)) {
+                    joinGroups(found->second, i);
+                    --open;
+                }
+            }
+        }
+
+        // Cerrar los grupos cuyas búsquedas se agotaron; el último grupo abierto conserva la etiqueta
+        for (int g = 0; g < count && open > 1; ++g) {
+            if (findGroup(g) != g || closed[g]) {
+                continue;
+            }
+            bool exhausted = true;
+            for (int i = 0; i < count; ++i) {
+                exhausted = exhausted && (findGroup(i) != g || heads[i] == queues[i].size());
+            }
+            if (!exhausted) {
+                continue;
+            }
+            std::int32_t piece = static_cast<std::int32_t>(componentSizes.size());
+            componentSizes.push_back(0);
+            for (int i = 0; i < count; ++i) {
+                if (findGroup(i) == g) {
+                    for (int index : queues[i]) {
+                        components[index] = piece;
+                    }
+                    componentSizes[piece] += static_cast<std::int32_t>(queues[i].size());
+                }
+            }
+            componentSizes[label] -= componentSizes[piece];
+            closed[g] = true;
+            --open;
+        }
+    }
+}
+
 // Verificar si dos celdas son adyacentes
-// Qué sucede: Devuelve `true` si dos celdas son adyacentes en el grafo según la matriz de adyacencia.
+// Qué sucede: Devuelve `true` si la segunda celda está en la máscara de vecinos de la primera.
 // Por qué sucede: Facilita la verificación de conectividad entre celdas para el pathfinding.
 bool Map::areCellsAdjacent(int x1, int y1, int x2, int y2) const {
-    int index1 = cellIndex(x1, y1);
-    int index2 = cellIndex(x2, y2);
-    return adjacencyMatrix[index1][index2] == 1;
-}
-
-// Convertir coordenadas de celda a índice de la matriz de adyacencia
-// Qué sucede: Convierte las coordenadas `x, y` a un índice lineal.
-// Por qué sucede: Permite acceder a la matriz de adyacencia usando índices en lugar de coordenadas 2D.
-int Map::cellIndex(int x, int y) const {
-    return y * size + x;  // Índice lineal para una celda en una matriz 2D
+    if (x1 < 0 || x1 >= size || y1 < 0 || y1 >= size) {
+        return false;
+    }
+    std::uint8_t mask = neighborData[cellIndex(x1, y1)];
+    if (y1 == y2 && x2 == x1 + 1) return (mask & NEIGHBOR_RIGHT) != 0;
+    if (y1 == y2 && x2 == x1 - 1) return (mask & NEIGHBOR_LEFT) != 0;
+    if (x1 == x2 && y2 == y1 + 1) return (mask & NEIGHBOR_DOWN) != 0;
+    if (x1 == x2 && y2 == y1 - 1) return (mask & NEIGHBOR_UP) != 0;
+    return false;
 }
@@ -2,19 +2,144 @@
 #define MAP_H
 
 #include <vector>
-#include "Tank.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "OccupancyGrid.h"
+#include "ChangeJournal.h"
+#include "Rng.h"
+#include "MapFile.h"
 
 class Map {
 public:
+    // Lado máximo de un mapa
+    // Por qué sucede: Los índices de celda (`y * size + x`) y los tamaños de componente son `int`; con un lado mayor,
+    //                 `size * size` desborda.
+    static constexpr int MAX_SIZE = 46340;
+
+    // Bits de la máscara de vecinos de cada celda (4-conexo).
+    // Qué sucede: Cada bit indica si la celda vecina en esa dirección es transitable.
+    // Por qué sucede: Reemplaza la matriz de adyacencia con 4 bits por celda.
+    enum NeighborBit : std::uint8_t {
+        NEIGHBOR_RIGHT = 1 << 0,  // (x + 1, y)
+        NEIGHBOR_LEFT  = 1 << 1,  // (x - 1, y)
+        NEIGHBOR_DOWN  = 1 << 2,  // (x, y + 1)
+        NEIGHBOR_UP    = 1 << 3   // (x, y - 1)
+    };
+
+    // Tipos de terreno de las celdas libres
+    // Qué sucede: Cada tipo tiene un costo entero chico por entrar a la celda (`getMoveCost`). El llano vale 2 para
+    //             que el camino pueda ser más barato que él.
+    // Por qué sucede: Dijkstra y A* eligen rutas por costo; BFS y Jump Point Search siguen contando celdas.
+    enum TerrainType : std::uint8_t {
+        TERRAIN_PLAIN = 0,  // Costo 2 (valor inicial de todas las celdas)
+        TERRAIN_ROAD = 1,  // Costo 1
+        TERRAIN_MUD = 2,  // Costo 5
+        TERRAIN_RUBBLE = 3,  // Costo 3
+        TERRAIN_TYPES = 4
+    };
+
+    static constexpr int MIN_MOVE_COST = 1;  // Costo del tipo más barato
+    static constexpr int MAX_MOVE_COST = 5;  // Costo del tipo más caro (cota de las colas por cubetas)
+
+    // Costo de entrar a una celda de un tipo de terreno (un byte inválido de un archivo no se sale de la tabla).
+    static int terrainCost(TerrainType type) {
+        static constexpr std::uint8_t costs[TERRAIN_TYPES] = {2, 1, 5, 3};
+        return costs[type & (TERRAIN_TYPES - 1)];
+    }
+
     // Constructor para inicializar el mapa con un tamaño específico.
-    // Qué sucede: Crea un mapa de tamaño `size x size` y establece la matriz de obstáculos y adyacencia.
+    // Qué sucede: Crea un mapa de tamaño `size x size` sin obstáculos y calcula los vecinos de cada celda.
     // Por qué sucede: El mapa define el área de juego y permite establecer relaciones entre celdas.
     Map(int size);
 
+    // Copiar un mapa
+    // Qué sucede: Los datos propios se copian y los que vienen de un archivo proyectado se comparten.
+    Map(const Map& other);
+    Map& operator=(const Map& other);
+
+    // Cargar un mapa desde un archivo (ver `MapFile`)
+    // Qué sucede: Los obstáculos y, si el archivo los trae, los vecinos, las componentes y el terreno se leen
+    //             directamente de la proyección, sin copiarlos; lo que no trae se calcula (el terreno queda llano).
+    //             La primera modificación copia los datos a memoria propia.
+    // Qué deberíamos esperar: `false` (y el mapa sin cambios) si el archivo no se pudo abrir o no es válido.
+    bool load(const std::string& path);
+
+    // Cargar un mapa de un archivo ya abierto con `MapFile::open` (varios mapas pueden compartirlo).
+    bool load(std::shared_ptr<const MapFile> mapped);
+
+    // Guardar el mapa en un archivo con las secciones opcionales de `flags`.
+    bool save(const std::string& path, unsigned flags = MAP_SAVE_ALL) const { return MapFile::write(path, *this, flags); }
+
+    // Verificar que `masks` sean las máscaras de vecinos que corresponden a los obstáculos `bits` de un mapa de lado
+    // `size` (para validar la sección de un archivo sin construir un `Map`).
+    static bool neighborMasksMatch(const std::uint64_t* bits, int size, const std::uint8_t* masks);
+
+    // Verificar si los datos del mapa se leen de un archivo proyectado (sin copia).
+    bool isMapped() const { return file != nullptr; }
+
     // Método para generar obstáculos en el mapa.
-    // Qué sucede: Llena la matriz `grid` con obstáculos, con base en el porcentaje especificado.
+    // Qué sucede: Marca obstáculos en el buffer de bits según el porcentaje especificado y recalcula los vecinos.
     // Por qué sucede: Los obstáculos crean desafíos en el movimiento de los tanques.
-    void generateObstacles(int percentage);
+    // Qué deberíamos esperar: El mismo estado de `rng` genera siempre el mismo mapa.
+    void generateObstacles(int percentage, Rng& rng);
+
+    // Reemplazar todos los obstáculos
+    // Qué sucede: `cells` tiene un byte por celda (distinto de 0 = obstáculo) en el orden de `cellIndex`; se empaqueta
+    //             en el buffer de bits y se recalculan los vecinos una sola vez.
+    // Por qué sucede: Los generadores arman la grilla por su cuenta (incluso en varios hilos) y la entregan entera.
+    // Qué deberíamos esperar: Con `connected`, el llamador garantiza que todas las celdas libres están conectadas y
+    //                         se les da una sola componente sin etiquetar el mapa.
+    void assignObstacles(const std::vector<std::uint8_t>& cells, bool connected = false);
+
+    // Reemplazar el terreno de todas las celdas
+    // Qué sucede: `types` tiene un `TerrainType` por celda en el orden de `cellIndex`. Como `assignObstacles`, es un
+    //             cambio masivo que reinicia el registro de cambios.
+    void assignTerrain(const std::vector<std::uint8_t>& types);
+
+    // Cambiar el terreno de una celda
+    // Qué sucede: Renueva la versión y anota la celda en el registro de cambios, igual que `setObstacle`.
+    void setTerrain(int x, int y, TerrainType type);
+
+    // Terreno de una celda (sin revisar límites).
+    TerrainType getTerrain(int x, int y) const { return static_cast<TerrainType>(terrainData[cellIndex(x, y)]); }
+
+    // Costo de entrar a la celda `index` (sin revisar límites).
+    int getMoveCost(int index) const { return terrainCost(static_cast<TerrainType>(terrainData[index])); }
+
+    // Menor costo de movimiento presente en el mapa
+    // Qué sucede: Se calcula al asignar el terreno y `setTerrain` solo puede bajarlo. Con el terreno de un archivo
+    //             proyectado es `MIN_MOVE_COST`, para no leer toda la sección al cargar.
+    // Por qué sucede: Multiplicada por la distancia Manhattan es la heurística admisible más fuerte para A*: sin
+    //                 caminos, cada paso cuesta al menos 2.
+    int getMinMoveCost() const { return minMoveCost; }
+
+    // Terreno de todas las celdas (fila por fila, un `TerrainType` por byte).
+    const std::uint8_t* getTerrainData() const { return terrainData; }
+
+    // Cambiar el estado de obstáculo de una celda.
+    // Qué sucede: Pone o quita el obstáculo, actualiza las máscaras de la celda y sus 4 vecinas y las componentes
+    //             conexas, y renueva la versión.
+    // Por qué sucede: Permite modificar el terreno sin recalcular los vecinos de todo el mapa.
+    void setObstacle(int x, int y, bool obstacle);
+
+    // Componente conexa de una celda
+    // Qué sucede: Dos celdas libres tienen la misma etiqueta si y solo si hay un camino entre ellas (sin contar
+    //             tanques); los obstáculos y las celdas fuera del mapa dan -1. Las etiquetas se calculan al generar o
+    //             cargar el mapa y `setObstacle` las mantiene al día.
+    // Qué deberíamos esperar: Etiquetas no negativas pero no necesariamente consecutivas.
+    int getComponent(int x, int y) const;
+
+    // Verificar si hay camino entre dos celdas
+    // Qué sucede: Compara las componentes de ambas celdas en O(1).
+    // Por qué sucede: Un destino inalcanzable hacía que las búsquedas recorrieran toda la zona del inicio para
+    //                 terminar sin ruta; la interfaz y la IA también lo usan para descartar destinos.
+    // Qué deberíamos esperar: `false` si alguna celda es un obstáculo o está fuera del mapa. Los tanques no se
+    //                         consideran: puede ser `true` y aun así no haber ruta libre en este momento.
+    bool isReachable(int startX, int startY, int endX, int endY) const;
+
+    // Etiquetas de componente de todas las celdas (fila por fila, -1 en obstáculos).
+    const std::int32_t* getComponentLabels() const { return componentData; }
 
     // Verificar si una celda contiene un obstáculo.
     // Qué sucede: Devuelve `true` si la celda especificada es un obstáculo.
@@ -29,37 +154,92 @@ public:
     // Verificar si una posición es válida y no contiene obstáculos ni tanques.
     // Qué sucede: Devuelve `true` si la posición es válida y no hay un tanque.
     // Por qué sucede: Evita colisiones entre tanques.
-    bool isValidPosition(int x, int y, const std::vector<Tank>& tanks) const;
+    bool isValidPosition(int x, int y, const OccupancyGrid& occupancy) const;
 
     // Obtener el tamaño del mapa.
     // Qué sucede: Devuelve el tamaño del mapa.
     // Por qué sucede: Es útil para límites y cálculos en otras partes del juego.
     int getSize() const;
 
-    // Dibujar el mapa en la ventana.
-    // Qué sucede: Dibuja cada celda, mostrando si es un obstáculo o no.
-    // Por qué sucede: Representa visualmente el estado del mapa en la ventana de juego.
-    void draw(sf::RenderWindow& window, int cellSize) const;
+    // Recalcular las máscaras de vecinos.
+    // Qué sucede: Calcula para cada celda libre qué vecinos (arriba, abajo, izquierda, derecha) son transitables.
+    // Por qué sucede: Para modelar el mapa como un grafo implícito que puede ser utilizado en pathfinding.
+    void rebuildNeighbors();
 
-    // Inicializar la matriz de adyacencia.
-    // Qué sucede: Calcula y establece las relaciones de adyacencia entre las celdas.
-    // Por qué sucede: Para modelar el mapa como un grafo que puede ser utilizado en pathfinding.
-    void initializeAdjacencyMatrix();
-
-    // Verificar si dos celdas son adyacentes según la matriz de adyacencia.
-    // Qué sucede: Devuelve `true` si dos celdas son adyacentes.
+    // Verificar si dos celdas son adyacentes en el grafo.
+    // Qué sucede: Devuelve `true` si ambas celdas son libres y vecinas en 4 direcciones.
     // Por qué sucede: Ayuda en la lógica del grafo para navegación y búsqueda de rutas.
     bool areCellsAdjacent(int x1, int y1, int x2, int y2) const;
 
+    // Obtener la máscara de vecinos de una celda.
+    // Qué sucede: Devuelve los bits `NeighborBit` de la celda; 0 para obstáculos.
+    // Por qué sucede: Permite a los algoritmos de búsqueda recorrer vecinos sin revisar límites ni obstáculos.
+    std::uint8_t getNeighborMask(int x, int y) const { return neighborData[cellIndex(x, y)]; }
+
+    // Buffer de bits de obstáculos (fila por fila, 64 celdas por palabra) y su cantidad de palabras.
+    const std::uint64_t* getObstacleWords() const { return obstacleData; }
+    std::size_t getObstacleWordCount() const { return (static_cast<std::size_t>(size) * size + 63) / 64; }
+
+    // Convertir coordenadas de celda en índice lineal (fila por fila).
+    // Qué sucede: Calcula `y * size + x`, el mismo orden que usan el buffer de obstáculos y los vecinos.
+    // Por qué sucede: Para acceder eficientemente a las celdas en estructuras unidimensionales.
+    int cellIndex(int x, int y) const { return y * size + x; }
+
+    // Obtener la versión del terreno.
+    // Qué sucede: Devuelve un sello que cambia cada vez que cambian los obstáculos. Los sellos salen de un contador
+    //             global, así que dos mapas distintos nunca comparten versión.
+    // Por qué sucede: Las estructuras derivadas (campos de flujo, cachés) detectan si quedaron desactualizadas.
+    std::uint64_t getVersion() const { return version; }
+
+    // Obtener las celdas cuyo obstáculo o terreno cambió desde una versión.
+    // Qué sucede: Consulta el registro de cambios de `setObstacle` y `setTerrain`; `generateObstacles` lo reinicia.
+    // Por qué sucede: Permite invalidar solo los datos derivados que pasan por celdas modificadas.
+    bool changedCellsSince(std::uint64_t sinceVersion, std::vector<int>& cells) const {
+        return journal.changesSince(sinceVersion, cells);
+    }
+
 private:
     int size;  // Tamaño del mapa (cantidad de celdas en cada dimensión).
-    std::vector<std::vector<bool>> grid;  // Matriz que indica la presencia de obstáculos en el mapa.
-    std::vector<std::vector<int>> adjacencyMatrix;  // Matriz de adyacencia para representar el grafo.
+    std::vector<std::uint64_t> obstacles;  // Buffer de bits fila por fila: 1 si la celda es un obstáculo.
+    std::vector<std::uint8_t> neighbors;  // Máscara de vecinos transitables por celda (grafo implícito).
+    const std::uint64_t* obstacleData;  // `obstacles.data()` o la sección del archivo proyectado
+    const std::uint8_t* neighborData;  // `neighbors.data()` o la sección del archivo proyectado
+    std::vector<std::int32_t> components;  // Componente conexa por celda (-1 en obstáculos)
+    std::vector<std::int32_t> componentSizes;  // Celdas por etiqueta; solo con datos propios (0 = etiqueta sin uso)
+    const std::int32_t* componentData;  // `components.data()` o la sección del archivo proyectado
+    std::vector<std::uint8_t> terrain;  // `TerrainType` por celda
+    const std::uint8_t* terrainData;  // `terrain.data()` o la sección del archivo proyectado
+    int minMoveCost;  // Menor costo de movimiento del terreno (ver `getMinMoveCost`)
+    std::shared_ptr<const MapFile> file;  // Archivo proyectado del que se leen los datos; nulo si son propios
+    std::uint64_t version;  // Versión del terreno; se renueva con cada cambio de obstáculos.
+    ChangeJournal journal;  // Últimas celdas modificadas con `setObstacle`.
 
-    // Convertir coordenadas de celda en índice de la matriz de adyacencia.
-    // Qué sucede: Calcula un índice lineal para una celda dada.
-    // Por qué sucede: Para acceder eficientemente a las celdas en estructuras unidimensionales.
-    int cellIndex(int x, int y) const;
+    // Calcular la máscara de vecinos de una celda a partir del buffer de obstáculos.
+    std::uint8_t computeNeighborMask(int x, int y) const;
+
+    // Escribir en `neighbors` las máscaras de todas las celdas a partir de `obstacleData`.
+    void fillNeighborMasks();
+
+    // Etiquetar todas las componentes conexas en `components` y contar sus celdas.
+    void labelComponents();
+
+    // Dar la etiqueta `to` a toda la componente de `from` que contiene la celda `seed`.
+    void relabelComponent(int seed, std::int32_t from, std::int32_t to);
+
+    // Separar la componente `label` tras bloquear una celda cuyas vecinas libres son `seeds`.
+    void splitComponent(std::int32_t label, const std::vector<int>& seeds);
+
+    // Consultar el bit de obstáculo de una celda sin revisar límites.
+    bool obstacleBit(int index) const { return (obstacleData[index >> 6] >> (index & 63)) & 1u; }
+
+    // Copiar a memoria propia los datos que vienen del archivo antes de modificarlos.
+    void makeWritable();
+
+    // Apuntar `obstacleData`, `neighborData`, `componentData` y `terrainData` a los datos propios o a las secciones del archivo.
+    void attachData();
+
+    // Recalcular `minMoveCost` recorriendo el terreno.
+    void updateMinMoveCost();
 };
 
 #endif
@@ -0,0 +1,195 @@
+#include "MapFile.h"
+#include "Map.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char kMagic[4] = {'T', 'A', 'M', 'P'};
+
+
+// Abrir y validar un archivo de mapa
+// Qué sucede: Proyecta el archivo completo y revisa que cada sección conocida tenga el tamaño que corresponde al lado
+//             del mapa y quede dentro del archivo. Las máscaras de vecinos y las componentes se comparan además con
+//             los obstáculos; si no coinciden se ignoran y `Map` las calcula.
+// Por qué sucede: Un archivo corrupto no debe dejar etiquetas fuera de rango (se usan como índices) ni vecinos que
+//                 atraviesan obstáculos.
+std::shared_ptr<const MapFile> MapFile::open(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(MapFileHeader)) {
+        ::close(fd);
+        return nullptr;
+    }
+    void* mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);  // La proyección sigue válida sin el descriptor
+    if (mapped == MAP_FAILED) {
+        return nullptr;
+    }
+
+    std::shared_ptr<MapFile> file(new MapFile());
+    file->data = static_cast<const std::uint8_t*>(mapped);
+    file->length = info.st_size;
+
+    MapFileHeader header;
+    std::memcpy(&header, file->data, sizeof(header));
+    std::uint64_t tableEnd = sizeof(header) + static_cast<std::uint64_t>(header.sectionCount) * sizeof(MapSectionEntry);
+    if (std::memcmp(header.magic, kMagic, 4) != 0 || header.version != VERSION ||
+        header.byteOrder != BYTE_ORDER_MARK || header.size < 2 || header.size > static_cast<std::uint32_t>(Map::MAX_SIZE) || tableEnd > file->length) {
+        return nullptr;
+    }
+
+    file->size = static_cast<int>(header.size);
+    std::uint64_t cells = static_cast<std::uint64_t>(header.size) * header.size;
+    file->obstacles = static_cast<const std::uint64_t*>(
+        file->findSection(MAP_SECTION_OBSTACLES, (cells + 63) / 64 * sizeof(std::uint64_t)));
+    file->neighbors = static_cast<const std::uint8_t*>(file->findSection(MAP_SECTION_NEIGHBORS, cells));
+    file->components = static_cast<const std::int32_t*>(
+        file->findSection(MAP_SECTION_COMPONENTS, cells * sizeof(std::int32_t)));
+    file->terrain = static_cast<const std::uint8_t*>(file->findSection(MAP_SECTION_TERRAIN, cells));
+    if (file->obstacles == nullptr) {
+        return nullptr;
+    }
+    if (file->neighbors != nullptr && !Map::neighborMasksMatch(file->obstacles, file->size, file->neighbors)) {
+        file->neighbors = nullptr;
+    }
+    if (file->components != nullptr && !file->componentsMatch()) {
+        file->components = nullptr;
+    }
+    return file;
+}
+
+MapFile::~MapFile() {
+    if (data != nullptr) {
+        munmap(const_cast<std::uint8_t*>(data), length);
+    }
+}
+
+const void* MapFile::findSection(MapSection type, std::uint64_t bytes) const {
+    MapFileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    for (std::uint32_t i = 0; i < header.sectionCount; ++i) {
+        MapSectionEntry entry;
+        std::memcpy(&entry, data + sizeof(header) + i * sizeof(MapSectionEntry), sizeof(entry));
+        if (entry.type != type) {
+            continue;
+        }
+        bool inside = entry.offset % SECTION_ALIGNMENT == 0 && entry.offset <= length && entry.bytes <= length - entry.offset;
+        return inside && entry.bytes == bytes ? data + entry.offset : nullptr;
+    }
+    return nullptr;
+}
+
+// Revisar las componentes
+// Qué sucede: Solo lee las etiquetas y los obstáculos, sin saltos que dependan de los datos dentro de cada palabra o
+//             fila (las diferencias se acumulan y se miran al final).
+// Qué deberíamos esperar: `true` si los obstáculos tienen -1, cada celda libre una etiqueta menor que la cantidad de
+//                         celdas (hay a lo sumo una componente por celda) y dos celdas libres vecinas la misma.
+bool MapFile::componentsMatch() const {
+    const std::uint64_t cells = static_cast<std::uint64_t>(size) * size;
+    const std::uint64_t words = (cells + 63) / 64;
+    for (std::uint64_t w = 0; w < words; ++w) {
+        const std::int32_t* labels = components + w * 64;
+        unsigned count = static_cast<unsigned>(std::min<std::uint64_t>(64, cells - w * 64));
+        std::uint64_t blocked = 0;
+        std::uint32_t outOfRange = 0;
+        for (unsigned i = 0; i < count; ++i) {
+            blocked |= std::uint64_t(labels[i] == -1) << i;
+            outOfRange |= static_cast<std::uint32_t>(labels[i] + 1) > cells;  // -1 pasa a 0
+        }
+        std::uint64_t valid = count < 64 ? (std::uint64_t(1) << count) - 1 : ~std::uint64_t(0);
+        if (outOfRange != 0 || blocked != (obstacles[w] & valid)) {
+            return false;
+        }
+    }
+
+    // Con -1 exactamente en los obstáculos, dos celdas vecinas son libres si ninguna etiqueta es negativa
+    for (int y = 0; y < size; ++y) {
+        const std::int32_t* labels = components + static_cast<std::uint64_t>(y) * size;
+        std::uint32_t different = 0;
+        for (int x = 0; x + 1 < size; ++x) {
+            different |= (labels[x] != labels[x + 1]) & ((labels[x] | labels[x + 1]) >= 0);
+        }
+        if (y + 1 < size) {
+            const std::int32_t* next = labels + size;
+            for (int x = 0; x < size; ++x) {
+                different |= (labels[x] != next[x]) & ((labels[x] | next[x]) >= 0);
+            }
+        }
+        if (different != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Escribir un mapa
+// Qué sucede: Arma el encabezado, la tabla de secciones y los arreglos (cada uno alineado a 64 bytes), los escribe en
+//             `path + ".tmp"` y después lo renombra a `path`.
+// Por qué sucede: Otros procesos pueden tener `path` proyectado; truncarlo y reescribirlo en el lugar les cambiaría
+//                 las secciones a mitad de partida (o daría SIGBUS). Con `rename` siguen viendo el archivo anterior.
+bool MapFile::write(const std::string& path, const Map& map, unsigned flags) {
+    int size = map.getSize();
+    std::size_t cells = static_cast<std::size_t>(size) * size;
+
+    std::vector<std::uint8_t> neighborMasks;
+    if (flags & MAP_SAVE_NEIGHBORS) {
+        neighborMasks.resize(cells);
+        for (std::size_t i = 0; i < cells; ++i) {
+            neighborMasks[i] = map.getNeighborMask(static_cast<int>(i % size), static_cast<int>(i / size));
+        }
+    }
+
+    struct Pending {
+        MapSection type;
+        const void* bytes;
+        std::size_t length;
+    };
+    std::vector<Pending> sections;
+    sections.push_back({MAP_SECTION_OBSTACLES, map.getObstacleWords(), map.getObstacleWordCount() * sizeof(std::uint64_t)});
+    if (!neighborMasks.empty()) {
+        sections.push_back({MAP_SECTION_NEIGHBORS, neighborMasks.data(), neighborMasks.size()});
+    }
+    if (flags & MAP_SAVE_COMPONENTS) {
+        // Las etiquetas ya están en el mapa: dos celdas libres comparten etiqueta si y solo si hay camino entre ellas
+        sections.push_back({MAP_SECTION_COMPONENTS, map.getComponentLabels(), cells * sizeof(std::int32_t)});
+    }
+    if (flags & MAP_SAVE_TERRAIN) {
+        sections.push_back({MAP_SECTION_TERRAIN, map.getTerrainData(), cells});
+    }
+
+    MapFileHeader header = {};
+    std::memcpy(header.magic, kMagic, 4);
+    header.version = VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.size = static_cast<std::uint32_t>(size);
+    header.sectionCount = static_cast<std::uint32_t>(sections.size());
+
+    std::vector<std::uint8_t> out(sizeof(header) + sections.size() * sizeof(MapSectionEntry));
+    std::memcpy(out.data(), &header, sizeof(header));
+    for (std::size_t i = 0; i < sections.size(); ++i) {
+        out.resize((out.size() + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT * SECTION_ALIGNMENT, 0);
+        MapSectionEntry entry = {sections[i].type, 0, out.size(), sections[i].length};
+        std::memcpy(out.data() + sizeof(header) + i * sizeof(MapSectionEntry), &entry, sizeof(entry));
+        const std::uint8_t* bytes = static_cast<const std::uint8_t*>(sections[i].bytes);
+        out.insert(out.end(), bytes, bytes + sections[i].length);
+    }
+
+    std::string temporary = path + ".tmp";
+    std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(out.data()), out.size());
+    file.close();
+    if (!file || std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,104 @@
+#ifndef MAP_FILE_H
+#define MAP_FILE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+class Map;
+
+// Secciones del archivo de mapa
+// Qué sucede: Cada sección guarda un arreglo por celda (o por palabra de 64 celdas) en el mismo orden fila por fila
+//             que `Map::cellIndex`. Las secciones desconocidas se ignoran, así que se pueden agregar tipos nuevos.
+enum MapSection : std::uint32_t {
+    MAP_SECTION_OBSTACLES = 1,  // Buffer de bits de obstáculos (`uint64_t` por cada 64 celdas); obligatoria
+    MAP_SECTION_NEIGHBORS = 2,  // Máscara de vecinos transitables (`uint8_t` por celda)
+    MAP_SECTION_COMPONENTS = 3,  // Componente conexa de cada celda (`int32_t`, -1 en obstáculos)
+    MAP_SECTION_TERRAIN = 4  // `Map::TerrainType` de cada celda (`uint8_t`); sin ella todo el terreno es llano
+};
+
+// Secciones opcionales que escribe `Map::save`
+enum MapSaveFlags : unsigned {
+    MAP_SAVE_NEIGHBORS = 1 << 0,
+    MAP_SAVE_COMPONENTS = 1 << 1,
+    MAP_SAVE_TERRAIN = 1 << 2,
+    MAP_SAVE_ALL = MAP_SAVE_NEIGHBORS | MAP_SAVE_COMPONENTS | MAP_SAVE_TERRAIN
+};
+
+// Encabezado del archivo (versión 1)
+// Qué sucede: Le sigue una tabla de `sectionCount` entradas `MapSectionEntry`. Todo se guarda en el orden de bytes de
+//             la máquina; `byteOrder` permite rechazar archivos escritos con el orden contrario.
+struct MapFileHeader {
+    char magic[4];  // "TAMP"
+    std::uint32_t version;
+    std::uint32_t byteOrder;  // `MapFile::BYTE_ORDER_MARK`
+    std::uint32_t size;  // Lado del mapa en celdas
+    std::uint32_t sectionCount;
+    std::uint32_t reserved;
+};
+
+// Entrada de la tabla de secciones
+// Qué sucede: `offset` es múltiplo de 64 bytes, así que los arreglos quedan alineados dentro del archivo mapeado.
+struct MapSectionEntry {
+    std::uint32_t type;  // `MapSection`
+    std::uint32_t reserved;
+    std::uint64_t offset;  // Desde el principio del archivo
+    std::uint64_t bytes;
+};
+
+// Archivo de mapa proyectado en memoria
+// Qué sucede: Abre el archivo con `mmap` de solo lectura, valida el encabezado y las secciones y entrega punteros
+//             directos a cada arreglo.
+// Por qué sucede: `Map` lee los obstáculos y los vecinos directamente de las páginas del archivo, sin copiarlos ni
+//                 recalcularlos; cargar un mapa grande cuesta lo que tarda el sistema en entregar las páginas y una
+//                 pasada para validarlas.
+// Qué deberíamos esperar: Varios `Map` (por ejemplo, las partidas de `tankattack-batch`) comparten las mismas páginas.
+//                         La proyección se libera cuando se destruye el último `shared_ptr`.
+class MapFile {
+public:
+    static constexpr std::uint32_t VERSION = 1;
+    static constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+    static constexpr std::size_t SECTION_ALIGNMENT = 64;
+
+    // Abrir y validar un archivo de mapa
+    // Qué deberíamos esperar: `nullptr` si el archivo no existe, no es un mapa, es de otra versión o está truncado.
+    static std::shared_ptr<const MapFile> open(const std::string& path);
+
+    ~MapFile();
+    MapFile(const MapFile&) = delete;
+    MapFile& operator=(const MapFile&) = delete;
+
+    int getSize() const { return size; }
+
+    // Arreglos de cada sección, o `nullptr` si el archivo no la tiene.
+    const std::uint64_t* getObstacles() const { return obstacles; }
+    const std::uint8_t* getNeighbors() const { return neighbors; }
+    const std::int32_t* getComponents() const { return components; }
+    const std::uint8_t* getTerrain() const { return terrain; }
+
+    // Escribir un mapa
+    // Qué sucede: Guarda los obstáculos y, según `flags`, las máscaras de vecinos, las componentes conexas y el terreno.
+    //             El archivo se reemplaza de una vez, así que quien ya lo tenía abierto sigue viendo el anterior.
+    // Qué deberíamos esperar: `false` si no se pudo escribir el archivo.
+    static bool write(const std::string& path, const Map& map, unsigned flags = MAP_SAVE_ALL);
+
+private:
+    MapFile() = default;
+
+    // Buscar una sección con exactamente `bytes` bytes
+    const void* findSection(MapSection type, std::uint64_t bytes) const;
+
+    // Revisar que las componentes coincidan con los obstáculos (los vecinos se revisan con `Map::neighborMasksMatch`)
+    bool componentsMatch() const;
+
+    const std::uint8_t* data = nullptr;  // Inicio de la proyección
+    std::size_t length = 0;  // Bytes proyectados
+    int size = 0;
+    const std::uint64_t* obstacles = nullptr;
+    const std::uint8_t* neighbors = nullptr;
+    const std::int32_t* components = nullptr;
+    const std::uint8_t* terrain = nullptr;
+};
+
+#endif
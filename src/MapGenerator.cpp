@@ -0,0 +1,416 @@
+#include "MapGenerator.h"
+#include "ThreadPool.h"
+#include "Rng.h"
+#include <algorithm>
+
+MapGenerator::MapGenerator(ThreadPool* pool) : pool(pool), size(0), regionsBeforeConnect(0) {}
+
+// Ejecutar una función por franja de filas
+// Qué sucede: `body(band, firstRow, endRow)` recibe las filas `[firstRow, endRow)` de la franja `band`.
+// Qué deberíamos esperar: Dos franjas nunca escriben las mismas celdas, así que pueden correr a la vez.
+template <typename Body>
+void MapGenerator::forEachBand(Body body) {
+    int bands = (size + BAND_ROWS - 1) / BAND_ROWS;
+    auto run = [&](int begin, int end) {
+        for (int band = begin; band < end; ++band) {
+            body(band, band * BAND_ROWS, std::min(size, (band + 1) * BAND_ROWS));
+        }
+    };
+    if (pool != nullptr && bands > 1) {
+        pool->parallelFor(bands, 1, [&](int begin, int end, int) { run(begin, end); });
+    } else {
+        run(0, bands);
+    }
+}
+
+// Generar los obstáculos
+// Qué sucede: Arma la grilla con la estrategia, la conecta si corresponde y la copia al mapa de una sola vez, y
+//             después hace lo mismo con el terreno.
+void MapGenerator::generate(Map& map, const GeneratorConfig& config, std::uint64_t seed) {
+    size = map.getSize();
+    cells.assign(static_cast<std::size_t>(size) * size, 0);
+
+    switch (config.strategy) {
+        case GENERATOR_NOISE:
+            fillNoise(config.obstaclePercentage, seed);
+            break;
+        case GENERATOR_CAVES:
+            fillNoise(config.obstaclePercentage, seed);
+            smoothCaves(config.caveIterations);
+            break;
+        case GENERATOR_ROOMS:
+            carveRooms(config.obstaclePercentage, seed);
+            break;
+    }
+
+    regionsBeforeConnect = 0;
+    if (config.connect) {
+        labelRegions();
+        connectRegions(config.minRegionCells);
+    }
+
+    map.assignObstacles(cells, config.connect);  // Conectado, el mapa no necesita volver a etiquetar las zonas
+    paintTerrain(config.terrainPercentage, seed);
+    map.assignTerrain(terrain);
+
+    // Liberar los búferes grandes: el generador puede vivir más que el mapa que generó
+    std::vector<std::uint8_t>().swap(scratch);
+    std::vector<std::uint8_t>().swap(terrain);
+    regions = UnionFind();
+}
+
+bool MapGenerator::parseStrategy(const std::string& name, GeneratorStrategy& strategy) {
+    if (name == "noise") {
+        strategy = GENERATOR_NOISE;
+    } else if (name == "caves") {
+        strategy = GENERATOR_CAVES;
+    } else if (name == "rooms") {
+        strategy = GENERATOR_ROOMS;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Ruido uniforme
+// Qué sucede: Cada franja usa un generador derivado de la semilla y del número de franja.
+void MapGenerator::fillNoise(int percentage, std::uint64_t seed) {
+    forEachBand([&](int band, int firstRow, int endRow) {
+        Rng rng(Rng::deriveSeed(seed, band));
+        std::uint8_t* out = cells.data();
+        const int end = endRow * size;
+        for (int i = firstRow * size; i < end; ++i) {
+            out[i] = rng.chance(percentage) ? 1 : 0;
+        }
+    });
+}
+
+// Suavizar con un autómata celular
+// Qué sucede: En cada pasada, una celda es pared si hay al menos 5 paredes en su vecindario de 3x3 (ella incluida);
+//             fuera del mapa cuenta como pared. Las sumas por columna de 3 filas se reutilizan para las 3 celdas
+//             que las comparten.
+// Qué deberíamos esperar: Con un relleno inicial cercano al 45% quedan cuevas amplias y redondeadas.
+void MapGenerator::smoothCaves(int iterations) {
+    scratch.resize(cells.size());
+    const std::vector<std::uint8_t> border(size, 1);  // Fila de paredes fuera del mapa
+    for (int iteration = 0; iteration < iterations; ++iteration) {
+        forEachBand([&](int, int firstRow, int endRow) {
+            const int n = size;  // Copia local: si no, cada byte escrito obligaría a releer `size`
+            std::vector<std::uint8_t> column(n + 2, 3);  // Paredes por columna en las filas y-1, y, y+1 (bordes = 3)
+            std::uint8_t* sums = column.data();
+            for (int y = firstRow; y < endRow; ++y) {
+                const std::uint8_t* row = &cells[static_cast<std::size_t>(y) * n];
+                const std::uint8_t* up = y > 0 ? row - n : border.data();
+                const std::uint8_t* down = y + 1 < n ? row + n : border.data();
+                // Bucles sin condiciones para que el compilador los vectorice
+                for (int x = 0; x < n; ++x) {
+                    sums[x + 1] = static_cast<std::uint8_t>(row[x] + up[x] + down[x]);
+                }
+                std::uint8_t* out = &scratch[static_cast<std::size_t>(y) * n];
+                for (int x = 0; x < n; ++x) {
+                    out[x] = sums[x] + sums[x + 1] + sums[x + 2] >= 5 ? 1 : 0;
+                }
+            }
+        });
+        cells.swap(scratch);
+    }
+}
+
+// Habitaciones y pasillos
+// Qué sucede: Empieza con todo pared y cava habitaciones rectangulares al azar, cada una unida a la anterior con un
+//             pasillo en L, hasta que las paredes bajan a `percentage`.
+// Por qué sucede: Cada habitación depende de la anterior, así que esta estrategia corre en un solo hilo; su costo es
+//                 proporcional al área cavada.
+void MapGenerator::carveRooms(int percentage, std::uint64_t seed) {
+    std::fill(cells.begin(), cells.end(), 1);
+    Rng rng(seed);
+    std::size_t total = cells.size();
+    std::size_t targetFree = total * (100 - std::min(std::max(percentage, 0), 100)) / 100;
+    std::size_t freeCells = 0;
+    int maxSide = std::max(4, size / 10);
+    int previousCenter = -1;
+
+    for (int attempt = 0; freeCells < targetFree && attempt < 1000000; ++attempt) {
+        int width = rng.range(3, maxSide);
+        int height = rng.range(3, maxSide);
+        int x0 = rng.range(0, std::max(0, size - width));
+        int y0 = rng.range(0, std::max(0, size - height));
+        int x1 = std::min(size, x0 + width);
+        int y1 = std::min(size, y0 + height);
+        for (int y = y0; y < y1; ++y) {
+            for (int x = x0; x < x1; ++x) {
+                std::uint8_t& cell = cells[static_cast<std::size_t>(y) * size + x];
+                freeCells += cell;  // Solo cuenta las paredes que se cavan ahora
+                cell = 0;
+            }
+        }
+
+        int center = ((y0 + y1) / 2) * size + (x0 + x1) / 2;
+        if (previousCenter != -1) {
+            freeCells += carveCorridor(previousCenter, center);
+        }
+        previousCenter = center;
+    }
+}
+
+// Etiquetar las zonas libres
+// Qué sucede: Cada franja recorre sus filas por tramos de celdas libres seguidas: todas las celdas del tramo apuntan
+//             a su primera celda, y el tramo se une con cada tramo de la fila de arriba que lo toca (sin salir de la
+//             franja). Después se unen la primera fila de cada franja con la última de la franja anterior.
+// Por qué sucede: Dentro de un tramo no hace falta buscar raíces, y entre dos filas basta una unión por cada par de
+//                 tramos que se tocan, en lugar de una por celda. Las paredes siguen siendo su propia raíz.
+void MapGenerator::labelRegions() {
+    regions.reset(static_cast<int>(cells.size()));
+    forEachBand([&](int, int firstRow, int endRow) {
+        const int n = size;  // Copia local: las escrituras en `regions` obligarían a releer `size`
+        for (int y = firstRow; y < endRow; ++y) {
+            const std::uint8_t* row = &cells[static_cast<std::size_t>(y) * n];
+            const std::uint8_t* up = y > firstRow ? row - n : nullptr;
+            int start = y * n;
+            for (int x = 0; x < n; ++x) {
+                int index = y * n + x;
+                bool leftFree = x > 0 && !row[x - 1];
+                start = leftFree ? start : index;
+                regions.attach(index, row[x] ? index : start);
+                // Unir con la fila de arriba al principio de cada tramo de arriba que toca a este
+                if (up && !row[x] && !up[x] && (!leftFree || up[x - 1])) {
+                    regions.unite(index, index - n);
+                }
+            }
+        }
+        regions.flatten(firstRow * n, endRow * n);  // Las uniones entre franjas buscan raíces en un salto
+    });
+
+    // Unir franjas vecinas
+    for (int y = BAND_ROWS; y < size; y += BAND_ROWS) {
+        for (int x = 0; x < size; ++x) {
+            int index = y * size + x;
+            if (!cells[index] && !cells[index - size] && (x == 0 || cells[index - 1] || cells[index - size - 1])) {
+                regions.unite(index, index - size);
+            }
+        }
+    }
+}
+
+// Dejar una sola zona libre
+// Qué sucede: La zona más grande es la principal y las de menos de `minRegionCells` celdas se rellenan. Cada una de
+//             las demás se une a la principal por el camino más corto: una búsqueda en anchura que sale de todas
+//             sus celdas, atraviesa paredes y se detiene en la primera celda ya conectada a la principal.
+// Por qué sucede: Cada búsqueda recorre solo la zona y su alrededor, no todo el mapa.
+// Qué deberíamos esperar: Los pasillos son lo más cortos posible y al cavarlos se unen también las zonas que cruzan.
+void MapGenerator::connectRegions(int minRegionCells) {
+    int total = static_cast<int>(cells.size());
+    std::vector<std::int32_t> info(total, 0);  // Primero: celdas por zona (en su raíz). Después: padre de la búsqueda
+    regions.flatten(0, total);
+
+    // Contar sin saltos: cada celda suma 1 a su raíz si está libre (una pared es su propia raíz y suma 0)
+    for (int index = 0; index < total; ++index) {
+        info[regions.parentOf(index)] += 1 - cells[index];
+    }
+    int mainRoot = -1;
+    std::vector<int> pending;
+    for (int index = 0; index < total; ++index) {
+        if (info[index] == 0) {
+            continue;
+        }
+        ++regionsBeforeConnect;
+        if (mainRoot == -1 || info[index] > info[mainRoot]) {
+            mainRoot = index;
+        }
+        if (info[index] >= minRegionCells) {
+            pending.push_back(index);
+        }
+    }
+    if (regionsBeforeConnect <= 1) {
+        return;
+    }
+    pending.erase(std::remove(pending.begin(), pending.end(), mainRoot), pending.end());
+
+    // Rellenar las zonas chicas (las paredes ya son 1, así que da igual si también cumplen la condición)
+    forEachBand([&](int, int firstRow, int endRow) {
+        std::uint8_t* out = cells.data();
+        const int end = endRow * size;
+        for (int index = firstRow * size; index < end; ++index) {
+            int root = regions.parentOf(index);
+            out[index] |= static_cast<std::uint8_t>(root != mainRoot && info[root] < minRegionCells);
+        }
+    });
+    if (pending.empty()) {
+        return;
+    }
+
+    // -1: sin visitar; -2: celda de la zona que se está uniendo; si no, la celda desde la que se llegó
+    std::fill(info.begin(), info.end(), -1);
+    std::vector<int> queue;
+    for (int root : pending) {
+        if (regions.find(root) == regions.find(mainRoot)) {
+            continue;  // Ya quedó unida al cavar el pasillo de otra zona
+        }
+
+        // Primero las celdas de la zona (todas a distancia 0), después el resto en anchura
+        queue.assign(1, root);
+        info[root] = -2;
+        int reached = -1;
+        for (int phase = 0; phase < 2 && reached == -1; ++phase) {
+            for (std::size_t head = 0; head < queue.size() && reached == -1; ++head) {
+                int at = queue[head];
+                int x = at % size;
+                int candidates[4] = {x + 1 < size ? at + 1 : -1, x > 0 ? at - 1 : -1,
+                                     at + size < total ? at + size : -1, at - size};
+                for (int next : candidates) {
+                    if (next < 0 || info[next] != -1 || (phase == 0 && cells[next])) {
+                        continue;
+                    }
+                    if (phase == 0) {
+                        info[next] = -2;
+                    } else {
+                        info[next] = at;
+                        if (!cells[next] && regions.find(next) == regions.find(mainRoot)) {
+                            reached = next;
+                            break;
+                        }
+                    }
+                    queue.push_back(next);
+                }
+            }
+        }
+
+        // Cavar desde la celda alcanzada hasta la zona y dejar `info` como estaba para la próxima búsqueda
+        for (int at = reached; at != -1 && info[at] != -2; at = info[at]) {
+            cells[at] = 0;
+            int x = at % size;
+            if (x + 1 < size && !cells[at + 1]) regions.unite(at, at + 1);
+            if (x > 0 && !cells[at - 1]) regions.unite(at, at - 1);
+            if (at + size < total && !cells[at + size]) regions.unite(at, at + size);
+            if (at - size >= 0 && !cells[at - size]) regions.unite(at, at - size);
+        }
+        if (reached != -1) {
+            info[reached] = -1;
+        }
+        for (int at : queue) {
+            info[at] = -1;
+        }
+    }
+}
+
+// Cavar un pasillo en L
+// Qué sucede: Primero en horizontal sobre la fila de `fromIndex` y después en vertical sobre la columna de `toIndex`.
+// Qué deberíamos esperar: Devuelve cuántas paredes se cavaron.
+std::size_t MapGenerator::carveCorridor(int fromIndex, int toIndex) {
+    int fx = fromIndex % size, fy = fromIndex / size;
+    int tx = toIndex % size, ty = toIndex / size;
+    std::size_t carved = 0;
+    for (int x = std::min(fx, tx); x <= std::max(fx, tx); ++x) {
+        std::uint8_t& cell = cells[static_cast<std::size_t>(fy) * size + x];
+        carved += cell;
+        cell = 0;
+    }
+    for (int y = std::min(fy, ty); y <= std::max(fy, ty); ++y) {
+        std::uint8_t& cell = cells[static_cast<std::size_t>(y) * size + tx];
+        carved += cell;
+        cell = 0;
+    }
+    return carved;
+}
+
+// Pintar el terreno
+// Qué sucede: Sobre las celdas libres, en este orden:
+//             - Charcos de barro: discos al azar hasta cubrir cerca de la mitad de `percentage`.
+//             - Escombros: cada celda libre junto a una pared lo es con probabilidad `percentage` (por franjas).
+//             - Caminos: filas y columnas rectas, una cada ~24 celdas, que pisan el barro y los escombros.
+// Por qué sucede: Con costos distintos, Dijkstra y A* rodean el barro y buscan los caminos, así que sus rutas ya
+//                 no coinciden con las de BFS. El generador usa su propia secuencia derivada de la semilla, así que
+//                 los obstáculos son los mismos con cualquier `percentage`.
+// Qué deberíamos esperar: Con `percentage` 0 todo queda llano.
+void MapGenerator::paintTerrain(int percentage, std::uint64_t seed) {
+    terrain.assign(cells.size(), Map::TERRAIN_PLAIN);
+    percentage = std::min(std::max(percentage, 0), 100);
+    if (percentage == 0) {
+        return;
+    }
+    std::uint64_t terrainSeed = Rng::deriveSeed(seed, ~std::uint64_t(0));  // Índice que ninguna franja usa
+    Rng rng(terrainSeed);
+
+    std::size_t freeCells = static_cast<std::size_t>(std::count(cells.begin(), cells.end(), 0));
+    std::size_t targetMud = freeCells * percentage / 200;
+    std::size_t mud = 0;
+    int maxRadius = std::max(2, size / 48);
+    for (int attempt = 0; mud < targetMud && attempt < 1000000; ++attempt) {
+        int radius = rng.range(1, maxRadius);
+        int cx = rng.range(0, size - 1);
+        int cy = rng.range(0, size - 1);
+        for (int y = std::max(0, cy - radius); y <= std::min(size - 1, cy + radius); ++y) {
+            for (int x = std::max(0, cx - radius); x <= std::min(size - 1, cx + radius); ++x) {
+                std::size_t index = static_cast<std::size_t>(y) * size + x;
+                bool inside = (x - cx) * (x - cx) + (y - cy) * (y - cy) <= radius * radius;
+                if (inside && !cells[index] && terrain[index] != Map::TERRAIN_MUD) {
+                    terrain[index] = Map::TERRAIN_MUD;
+                    ++mud;
+                }
+            }
+        }
+    }
+
+    // Escombros: en cada fila se marcan primero, sin condiciones, las celdas libres y llanas junto a una pared; el
+    // sorteo solo recorre esas candidatas, en el mismo orden que una celda por vez
+    const std::vector<std::uint8_t> open(size, 0);  // Fila sin paredes fuera del mapa
+    forEachBand([&](int band, int firstRow, int endRow) {
+        Rng bandRng(Rng::deriveSeed(terrainSeed, band));
+        const int n = size;
+        std::vector<std::uint64_t> candidateBits((n + 63) / 64);
+        for (int y = firstRow; y < endRow; ++y) {
+            const std::uint8_t* row = &cells[static_cast<std::size_t>(y) * n];
+            const std::uint8_t* up = y > 0 ? row - n : open.data();
+            const std::uint8_t* down = y + 1 < n ? row + n : open.data();
+            std::uint8_t* out = &terrain[static_cast<std::size_t>(y) * n];
+            for (int w = 0; w * 64 < n; ++w) {
+                int first = w * 64;
+                int count = std::min(64, n - first);
+                std::uint64_t bits = 0;
+                for (int i = 0; i < count; ++i) {
+                    int x = first + i;
+                    std::uint8_t nearWall = up[x] | down[x] | (x > 0 ? row[x - 1] : 0) | (x + 1 < n ? row[x + 1] : 0);
+                    std::uint8_t candidate = nearWall & (row[x] ^ 1) & (out[x] == Map::TERRAIN_PLAIN);
+                    bits |= std::uint64_t(candidate) << i;
+                }
+                candidateBits[w] = bits;
+            }
+            for (int w = 0; w * 64 < n; ++w) {
+                for (std::uint64_t bits = candidateBits[w]; bits != 0; bits &= bits - 1) {
+                    int x = w * 64 + __builtin_ctzll(bits);
+                    if (bandRng.chance(percentage)) {
+                        out[x] = Map::TERRAIN_RUBBLE;
+                    }
+                }
+            }
+        }
+    });
+
+    // Caminos: se sortean todos primero y se pintan por franjas, fila por fila, en vez de recorrer cada columna de
+    // arriba abajo
+    int roads = std::max(1, size / 24);
+    std::vector<int> roadRows(roads);
+    std::vector<int> roadColumns(roads);
+    for (int road = 0; road < roads; ++road) {
+        roadRows[road] = rng.range(0, size - 1);
+        roadColumns[road] = rng.range(0, size - 1);
+    }
+    std::sort(roadRows.begin(), roadRows.end());
+    std::sort(roadColumns.begin(), roadColumns.end());
+    forEachBand([&](int, int firstRow, int endRow) {
+        const int n = size;
+        for (int y = firstRow; y < endRow; ++y) {
+            const std::uint8_t* row = &cells[static_cast<std::size_t>(y) * n];
+            std::uint8_t* out = &terrain[static_cast<std::size_t>(y) * n];
+            if (std::binary_search(roadRows.begin(), roadRows.end(), y)) {
+                for (int x = 0; x < n; ++x) {
+                    out[x] = row[x] ? out[x] : static_cast<std::uint8_t>(Map::TERRAIN_ROAD);
+                }
+            } else {
+                for (int x : roadColumns) {
+                    out[x] = row[x] ? out[x] : static_cast<std::uint8_t>(Map::TERRAIN_ROAD);
+                }
+            }
+        }
+    });
+}
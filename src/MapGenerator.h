@@ -0,0 +1,77 @@
+#ifndef MAP_GENERATOR_H
+#define MAP_GENERATOR_H
+
+#include "Map.h"
+#include "UnionFind.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class ThreadPool;
+
+// Estrategias de generación de obstáculos
+enum GeneratorStrategy {
+    GENERATOR_NOISE,  // Cada celda es obstáculo con probabilidad `obstaclePercentage` (como `generateObstacles`)
+    GENERATOR_CAVES,  // Ruido inicial suavizado con un autómata celular: cuevas de paredes redondeadas
+    GENERATOR_ROOMS  // Habitaciones rectangulares unidas por pasillos sobre un mapa lleno de paredes
+};
+
+// Parámetros de la generación
+struct GeneratorConfig {
+    GeneratorStrategy strategy = GENERATOR_NOISE;
+    int obstaclePercentage = 10;  // Ruido y cuevas: relleno inicial; habitaciones: paredes que quedan como máximo
+    int caveIterations = 4;  // Pasadas del autómata celular en `GENERATOR_CAVES`
+    int minRegionCells = 16;  // Las zonas aisladas más chicas se rellenan; las demás se unen con un pasillo
+    bool connect = true;  // Garantizar que todas las celdas libres estén conectadas
+    int terrainPercentage = 0;  // Celdas libres con barro o escombros (aprox.), además de los caminos; 0 = todo llano
+};
+
+// Generador de mapas con conectividad garantizada
+// Qué sucede: Genera los obstáculos con la estrategia elegida en franjas de `BAND_ROWS` filas (cada franja con su
+//             propio generador derivado de la semilla), etiqueta las zonas libres con union-find por franjas y une las
+//             franjas vecinas, y luego deja una sola zona: las zonas chicas se rellenan y las grandes se conectan a
+//             la principal con un pasillo en L. Por último pinta el terreno de las celdas libres.
+// Por qué sucede: Con obstáculos independientes por celda podían quedar zonas encerradas; un tanque atrapado hacía
+//                 que las búsquedas recorrieran todo el mapa para terminar sin ruta.
+// Qué deberíamos esperar: Con `connect`, todas las celdas libres son alcanzables entre sí. La misma semilla produce
+//                         el mismo mapa con cualquier cantidad de hilos, porque las franjas no dependen de ellos.
+class MapGenerator {
+public:
+    static constexpr int BAND_ROWS = 64;  // Filas por franja (unidad de trabajo en paralelo)
+
+    // Constructor
+    // Qué sucede: Con `pool` las franjas se reparten entre sus hilos; sin él todo corre en el hilo actual.
+    explicit MapGenerator(ThreadPool* pool = nullptr);
+
+    // Generar los obstáculos y el terreno de `map` (reemplaza los que tenga).
+    void generate(Map& map, const GeneratorConfig& config, std::uint64_t seed);
+
+    // Interpretar el nombre de una estrategia (`noise`, `caves` o `rooms`) para las opciones de línea de comandos.
+    static bool parseStrategy(const std::string& name, GeneratorStrategy& strategy);
+
+    // Cantidad de zonas libres antes de conectarlas en la última generación (útil para medir la estrategia).
+    int getRegionsBeforeConnect() const { return regionsBeforeConnect; }
+
+private:
+    ThreadPool* pool;
+    int size;
+    std::vector<std::uint8_t> cells;  // 1 si la celda es obstáculo, fila por fila
+    std::vector<std::uint8_t> scratch;  // Segundo búfer del autómata celular
+    std::vector<std::uint8_t> terrain;  // `Map::TerrainType` por celda
+    UnionFind regions;
+    int regionsBeforeConnect;
+
+    // Ejecutar `body(firstRow, endRow)` para cada franja, en paralelo si hay pool.
+    template <typename Body>
+    void forEachBand(Body body);
+
+    void fillNoise(int percentage, std::uint64_t seed);
+    void smoothCaves(int iterations);
+    void carveRooms(int percentage, std::uint64_t seed);
+    void labelRegions();
+    void connectRegions(int minRegionCells);
+    std::size_t carveCorridor(int fromIndex, int toIndex);
+    void paintTerrain(int percentage, std::uint64_t seed);
+};
+
+#endif
@@ -0,0 +1,92 @@
+#include "MatchRunner.h"
+#include <algorithm>
+#include <chrono>
+
+MatchRunner::MatchRunner(int threadCount) : pool(threadCount) {}
+
+// Jugar una sola partida
+// Qué sucede: Los dos jugadores generan sus entradas y la partida avanza un tick hasta que termina.
+MatchResult MatchRunner::playMatch(const GameConfig& config, PlayerStrategy player1, PlayerStrategy player2) {
+    GameState state(config);
+    AutoPlayer players[2] = {AutoPlayer(1, player1, Rng::deriveSeed(config.seed, 1)),
+                             AutoPlayer(2, player2, Rng::deriveSeed(config.seed, 2))};
+    std::vector<GameInput> inputs;
+
+    while (!state.isGameOver()) {
+        inputs.clear();
+        players[0].think(state, inputs);
+        players[1].think(state, inputs);
+        state.step(inputs);
+    }
+
+    return {config.seed, state.getWinner(), state.getTick(), state.countAliveTanks(1), state.countAliveTanks(2)};
+}
+
+// Jugar un lote
+// Qué sucede: Cada partida escribe en su propia posición de `results`, así no hace falta sincronizar.
+BatchStats MatchRunner::run(const GameConfig& config, int matches, PlayerStrategy player1, PlayerStrategy player2,
+                            std::vector<MatchResult>& results) {
+    results.assign(matches, MatchResult());
+
+    auto start = std::chrono::steady_clock::now();
+    pool.parallelFor(matches, 1, [&](int begin, int end, int) {
+        for (int i = begin; i < end; ++i) {
+            GameConfig matchConfig = config;
+            matchConfig.seed = Rng::deriveSeed(config.seed, static_cast<std::uint64_t>(i));
+            matchConfig.verbose = false;
+            results[i] = playMatch(matchConfig, player1, player2);
+        }
+    });
+
+    BatchStats stats;
+    stats.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    stats.matches = matches;
+    stats.threads = pool.getThreadCount();
+    for (int i = 0; i < matches; ++i) {
+        const MatchResult& result = results[i];
+        if (result.winner == 1) {
+            stats.player1Wins++;
+        } else if (result.winner == 2) {
+            stats.player2Wins++;
+        } else {
+            stats.draws++;
+        }
+        stats.totalTicks += result.ticks;
+        stats.minTicks = (i == 0) ? result.ticks : std::min(stats.minTicks, result.ticks);
+        stats.maxTicks = std::max(stats.maxTicks, result.ticks);
+    }
+    return stats;
+}
+
+// Escribir las estadísticas en CSV
+void writeStatsCsv(std::ostream& out, const BatchStats& stats) {
+    double matches = stats.matches > 0 ? stats.matches : 1;
+    out << "matches,threads,player1_wins,player2_wins,draws,player1_win_rate,player2_win_rate,draw_rate,"
+           "mean_ticks,min_ticks,max_ticks,wall_seconds,matches_per_second,ticks_per_second\n";
+    out << stats.matches << ',' << stats.threads << ','
+        << stats.player1Wins << ',' << stats.player2Wins << ',' << stats.draws << ','
+        << stats.player1Wins / matches << ',' << stats.player2Wins / matches << ',' << stats.draws / matches << ','
+        << stats.meanTicks() << ',' << stats.minTicks << ',' << stats.maxTicks << ','
+        << stats.wallSeconds << ',' << stats.matchesPerSecond() << ',' << stats.ticksPerSecond() << '\n';
+}
+
+// Escribir las estadísticas en JSON
+void writeStatsJson(std::ostream& out, const BatchStats& stats) {
+    double matches = stats.matches > 0 ? stats.matches : 1;
+    out << "{\n"
+        << "  \"matches\": " << stats.matches << ",\n"
+        << "  \"threads\": " << stats.threads << ",\n"
+        << "  \"player1_wins\": " << stats.player1Wins << ",\n"
+        << "  \"player2_wins\": " << stats.player2Wins << ",\n"
+        << "  \"draws\": " << stats.draws << ",\n"
+        << "  \"player1_win_rate\": " << stats.player1Wins / matches << ",\n"
+        << "  \"player2_win_rate\": " << stats.player2Wins / matches << ",\n"
+        << "  \"draw_rate\": " << stats.draws / matches << ",\n"
+        << "  \"mean_ticks\": " << stats.meanTicks() << ",\n"
+        << "  \"min_ticks\": " << stats.minTicks << ",\n"
+        << "  \"max_ticks\": " << stats.maxTicks << ",\n"
+        << "  \"wall_seconds\": " << stats.wallSeconds << ",\n"
+        << "  \"matches_per_second\": " << stats.matchesPerSecond() << ",\n"
+        << "  \"ticks_per_second\": " << stats.ticksPerSecond() << "\n"
+        << "}\n";
+}
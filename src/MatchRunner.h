@@ -0,0 +1,69 @@
+#ifndef MATCH_RUNNER_H
+#define MATCH_RUNNER_H
+
+#include "GameState.h"
+#include "AutoPlayer.h"
+#include "ThreadPool.h"
+#include <vector>
+#include <cstdint>
+#include <ostream>
+
+// Resultado de una partida sin ventana
+struct MatchResult {
+    std::uint64_t seed;  // Semilla de la partida
+    int winner;  // 1, 2 o 0 (empate)
+    std::uint64_t ticks;  // Ticks simulados hasta el final
+    int player1Alive;  // Tanques vivos del jugador 1 al terminar
+    int player2Alive;  // Tanques vivos del jugador 2 al terminar
+};
+
+// Estadísticas agregadas de un lote de partidas
+struct BatchStats {
+    int matches = 0;
+    int threads = 0;
+    int player1Wins = 0;
+    int player2Wins = 0;
+    int draws = 0;
+    std::uint64_t totalTicks = 0;
+    std::uint64_t minTicks = 0;
+    std::uint64_t maxTicks = 0;
+    double wallSeconds = 0.0;  // Tiempo real de todo el lote
+
+    double meanTicks() const { return matches > 0 ? static_cast<double>(totalTicks) / matches : 0.0; }
+    double matchesPerSecond() const { return wallSeconds > 0 ? matches / wallSeconds : 0.0; }
+    double ticksPerSecond() const { return wallSeconds > 0 ? totalTicks / wallSeconds : 0.0; }
+};
+
+// Corredor de partidas en paralelo
+// Qué sucede: Reparte las partidas entre los hilos de un `ThreadPool`. Cada partida crea su propio `GameState` y sus
+//             dos `AutoPlayer`, con semillas derivadas de la semilla del lote y del número de partida.
+// Por qué sucede: Evaluar IAs requiere miles de partidas; son independientes y no comparten estado, así que escalan
+//                 con los núcleos.
+// Qué deberíamos esperar: Los resultados quedan en el orden de las partidas, sin importar qué hilo corrió cada una.
+class MatchRunner {
+public:
+    // Constructor
+    // Qué sucede: Lanza `threadCount` hilos; con 0 usa la cantidad de núcleos disponibles.
+    explicit MatchRunner(int threadCount = 0);
+
+    // Jugar un lote
+    // Qué sucede: Juega `matches` partidas con la configuración `config`; la partida `i` usa la semilla
+    //             `Rng::deriveSeed(config.seed, i)`.
+    // Qué deberíamos esperar: `results[i]` es el resultado de la partida `i` y el valor devuelto resume todo el lote.
+    BatchStats run(const GameConfig& config, int matches, PlayerStrategy player1, PlayerStrategy player2,
+                   std::vector<MatchResult>& results);
+
+    int getThreadCount() const { return pool.getThreadCount(); }
+
+    // Jugar una sola partida en el hilo actual.
+    static MatchResult playMatch(const GameConfig& config, PlayerStrategy player1, PlayerStrategy player2);
+
+private:
+    ThreadPool pool;
+};
+
+// Escribir las estadísticas en CSV (encabezado y una fila) o en JSON (un objeto).
+void writeStatsCsv(std::ostream& out, const BatchStats& stats);
+void writeStatsJson(std::ostream& out, const BatchStats& stats);
+
+#endif
@@ -0,0 +1,42 @@
+#include "OccupancyGrid.h"
+
+// Constructor de la capa de ocupación
+// Qué sucede: Reserva una celda por posición del mapa, todas libres.
+OccupancyGrid::OccupancyGrid(int size)
+    : size(size), cells(size * size, EMPTY), version(ChangeJournal::newVersion()) {
+    journal.reset(version);
+}
+
+// Anotar el cambio de una celda
+// Qué sucede: Renueva la versión y registra la celda en el historial de cambios.
+void OccupancyGrid::touch(int index) {
+    version = ChangeJournal::newVersion();
+    journal.record(version, index);
+}
+
+// Colocar un tanque
+// Qué sucede: Registra el ID del tanque en la celda indicada.
+// Por qué sucede: Se llama al crear un tanque para que la capa conozca su posición inicial.
+void OccupancyGrid::place(int tankId, int x, int y) {
+    if (inBounds(x, y)) {
+        cells[y * size + x] = tankId;
+        touch(y * size + x);
+    }
+}
+
+// Mover un tanque
+// Qué sucede: Libera la celda de origen y ocupa la de destino.
+// Por qué sucede: Mantiene la capa sincronizada con `Tank::setPosition`.
+void OccupancyGrid::move(int tankId, int fromX, int fromY, int toX, int toY) {
+    remove(tankId, fromX, fromY);
+    place(tankId, toX, toY);
+}
+
+// Liberar la celda de un tanque
+// Qué sucede: Solo libera la celda si la ocupa ese tanque, para no borrar a otro tanque por error.
+void OccupancyGrid::remove(int tankId, int x, int y) {
+    if (inBounds(x, y) && cells[y * size + x] == tankId) {
+        cells[y * size + x] = EMPTY;
+        touch(y * size + x);
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef OCCUPANCY_GRID_H
+#define OCCUPANCY_GRID_H
+
+#include <vector>
+#include <cstdint>
+#include "ChangeJournal.h"
+
+// Capa de ocupación de tanques sobre el mapa
+// Qué sucede: Guarda para cada celda el ID del tanque que la ocupa, o `EMPTY` si está libre.
+// Por qué sucede: Consultar la ocupación recorriendo todo el vector de tanques hacía que cada búsqueda de rutas
+//                 fuera O(celdas x tanques); con esta capa cada consulta es O(1).
+// Qué deberíamos esperar: Se mantiene al día desde `Tank::setPosition` y al retirar tanques destruidos.
+class OccupancyGrid {
+public:
+    static constexpr int EMPTY = -1;
+
+    // Constructor
+    // Qué sucede: Crea una capa de `size x size` celdas, todas libres.
+    explicit OccupancyGrid(int size);
+
+    // Obtener el tamaño de la capa (igual al del mapa).
+    int getSize() const { return size; }
+
+    // Verificar si una celda tiene un tanque
+    // Qué sucede: Devuelve `true` si la celda está dentro del mapa y la ocupa algún tanque.
+    bool isOccupied(int x, int y) const { return tankAt(x, y) != EMPTY; }
+
+    // Obtener el ID del tanque en una celda
+    // Qué sucede: Devuelve el ID del tanque o `EMPTY` si la celda está libre o fuera del mapa.
+    int tankAt(int x, int y) const {
+        if (x < 0 || x >= size || y < 0 || y >= size) {
+            return EMPTY;
+        }
+        return cells[y * size + x];
+    }
+
+    // Colocar un tanque en una celda.
+    void place(int tankId, int x, int y);
+
+    // Mover un tanque de una celda a otra
+    // Qué sucede: Libera la celda de origen (si la ocupaba ese tanque) y ocupa la de destino.
+    void move(int tankId, int fromX, int fromY, int toX, int toY);
+
+    // Versión de la ocupación
+    // Qué sucede: Cambia cada vez que un tanque se coloca, se mueve o se retira; el registro guarda qué celdas cambiaron.
+    // Por qué sucede: La caché de rutas valida sus entradas sin recalcularlas si ninguna celda de la ruta cambió.
+    std::uint64_t getVersion() const { return version; }
+    bool changedCellsSince(std::uint64_t sinceVersion, std::vector<int>& changed) const {
+        return journal.changesSince(sinceVersion, changed);
+    }
+
+    // Liberar la celda de un tanque
+    // Qué sucede: Marca la celda como libre si la ocupaba el tanque indicado.
+    // Por qué sucede: Se usa al retirar tanques destruidos del juego.
+    void remove(int tankId, int x, int y);
+
+private:
+    int size;  // Tamaño del mapa (cantidad de celdas en cada dimensión)
+    std::vector<int> cells;  // ID del tanque por celda, fila por fila (mismo orden que `Map::cellIndex`)
+    std::uint64_t version;  // Versión actual de la ocupación
+    ChangeJournal journal;  // Últimas celdas cuya ocupación cambió
+
+    // Anotar el cambio de una celda con una versión nueva.
+    void touch(int index);
+
+    bool inBounds(int x, int y) const { return x >= 0 && x < size && y >= 0 && y < size; }
+};
+
+#endif
@@ -0,0 +1,94 @@
+#include "PathCache.h"
+#include <algorithm>
+
+// Constructor
+// Qué sucede: Define la capacidad máxima; la caché empieza vacía.
+PathCache::PathCache(std::size_t capacity)
+    : capacity(capacity == 0 ? 1 : capacity), hits(0), misses(0), invalidations(0) {}
+
+// Buscar una ruta usando la caché
+// Qué sucede: Si existe una entrada válida, se mueve al frente (más reciente) y se devuelve su ruta. Si no,
+//             se calcula, se inserta al frente y se descarta la menos reciente si se supera la capacidad.
+std::vector<Cell> PathCache::findPath(PathAlgorithm algorithm, const Map& map, const OccupancyGrid& occupancy,
+                                      int startX, int startY, int endX, int endY) {
+    Key key = {map.cellIndex(startX, startY), map.cellIndex(endX, endY), static_cast<int>(algorithm)};
+
+    auto found = index.find(key);
+    if (found != index.end()) {
+        if (isStillValid(*found->second, map, occupancy)) {
+            ++hits;
+            entries.splice(entries.begin(), entries, found->second);
+            return found->second->path;
+        }
+        ++invalidations;
+        entries.erase(found->second);
+        index.erase(found);
+    }
+
+    ++misses;
+    Entry entry;
+    entry.key = key;
+    entry.map = &map;
+    entry.mapVersion = map.getVersion();
+    entry.occupancyVersion = occupancy.getVersion();
+    entry.path = ::findPath(algorithm, map, startX, startY, endX, endY, occupancy, workspace);
+    entry.pathCells.reserve(entry.path.size());
+    for (const Cell& cell : entry.path) {
+        entry.pathCells.push_back(map.cellIndex(cell.x, cell.y));
+    }
+    std::sort(entry.pathCells.begin(), entry.pathCells.end());
+
+    entries.push_front(std::move(entry));
+    index[key] = entries.begin();
+    if (entries.size() > capacity) {
+        index.erase(entries.back().key);
+        entries.pop_back();
+    }
+    return entries.front().path;
+}
+
+// Vaciar la caché
+void PathCache::clear() {
+    entries.clear();
+    index.clear();
+}
+
+// Validar una entrada
+// Qué sucede: Si las versiones coinciden es válida. Si no, revisa las celdas cambiadas desde su cálculo:
+//             - Si el historial ya no cubre esa versión, o la ruta está vacía, la entrada se descarta.
+//             - Si ninguna celda cambiada está sobre la ruta, se actualizan sus versiones y sigue siendo válida.
+// Por qué sucede: En la ocupación se ignora la celda de inicio, donde está el propio tanque que se moverá.
+bool PathCache::isStillValid(Entry& entry, const Map& map, const OccupancyGrid& occupancy) {
+    if (entry.map != &map) {
+        return false;
+    }
+
+    if (entry.mapVersion != map.getVersion()) {
+        changed.clear();
+        if (entry.path.empty() || !map.changedCellsSince(entry.mapVersion, changed) || pathTouches(entry, changed, -1)) {
+            return false;
+        }
+        entry.mapVersion = map.getVersion();
+    }
+
+    if (entry.occupancyVersion != occupancy.getVersion()) {
+        changed.clear();
+        if (entry.path.empty() || !occupancy.changedCellsSince(entry.occupancyVersion, changed) ||
+            pathTouches(entry, changed, entry.key.start)) {
+            return false;
+        }
+        entry.occupancyVersion = occupancy.getVersion();
+    }
+
+    return true;
+}
+
+// Verificar si alguna celda cambiada está sobre la ruta
+bool PathCache::pathTouches(const Entry& entry, const std::vector<int>& cells, int ignoredCell) const {
+    for (int cell : cells) {
+        if (cell != ignoredCell && std::binary_search(entry.pathCells.begin(), entry.pathCells.end(), cell)) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,78 @@
+#ifndef PATH_CACHE_H
+#define PATH_CACHE_H
+
+#include "Map.h"
+#include "OccupancyGrid.h"
+#include "Pathfinding.h"
+#include "SearchWorkspace.h"
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+// Caché de rutas con invalidación por celdas
+// Qué sucede: Se coloca delante de las funciones de búsqueda. Cada entrada se identifica por (inicio, destino,
+//             algoritmo) y guarda la versión del mapa y de la ocupación con las que se calculó. Si esas versiones
+//             cambiaron, se consultan los registros de cambios y la entrada solo se descarta si alguna celda
+//             modificada está sobre su ruta.
+// Por qué sucede: Volver a hacer clic en el mismo destino o que la IA replanifique cada turno recalculaba todo.
+// Qué deberíamos esperar: Política LRU acotada a `capacity` entradas y contadores de aciertos, fallos e invalidaciones.
+//                         Una ruta validada sigue siendo transitable, aunque una celda liberada fuera de ella podría
+//                         haber abierto un atajo; las rutas vacías (sin camino) se descartan ante cualquier cambio.
+class PathCache {
+public:
+    explicit PathCache(std::size_t capacity = 256);
+
+    // Buscar una ruta usando la caché
+    // Qué sucede: Devuelve la ruta guardada si sigue siendo válida; si no, la calcula con `algorithm` y la guarda.
+    std::vector<Cell> findPath(PathAlgorithm algorithm, const Map& map, const OccupancyGrid& occupancy,
+                               int startX, int startY, int endX, int endY);
+
+    void clear();
+
+    std::size_t size() const { return entries.size(); }
+    std::size_t getHits() const { return hits; }
+    std::size_t getMisses() const { return misses; }
+    std::size_t getInvalidations() const { return invalidations; }
+
+private:
+    struct Key {
+        int start;
+        int goal;
+        int algorithm;
+        bool operator==(const Key& other) const {
+            return start == other.start && goal == other.goal && algorithm == other.algorithm;
+        }
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const {
+            std::uint64_t packed = (static_cast<std::uint64_t>(static_cast<std::uint32_t>(key.start)) << 32) ^
+                                   static_cast<std::uint32_t>(key.goal) ^
+                                   (static_cast<std::uint64_t>(key.algorithm) << 61);
+            return std::hash<std::uint64_t>()(packed);
+        }
+    };
+
+    struct Entry {
+        Key key;
+        const Map* map;  // Mapa con el que se calculó (las versiones son únicas, esto solo evita mezclar mapas)
+        std::uint64_t mapVersion;
+        std::uint64_t occupancyVersion;
+        std::vector<Cell> path;
+        std::vector<int> pathCells;  // Índices de celda de la ruta, ordenados para búsqueda binaria
+    };
+
+    std::size_t capacity;  // Máximo de entradas guardadas
+    std::list<Entry> entries;  // Entradas de más a menos reciente
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;  // Acceso por clave
+    SearchWorkspace workspace;  // Espacio de trabajo para los fallos de caché
+    std::vector<int> changed;  // Búfer reutilizable de celdas cambiadas
+    std::size_t hits, misses, invalidations;  // Estadísticas
+
+    bool isStillValid(Entry& entry, const Map& map, const OccupancyGrid& occupancy);
+    bool pathTouches(const Entry& entry, const std::vector<int>& cells, int ignoredCell) const;
+};
+
+#endif
@@ -1,60 +1,117 @@
 #include "Pathfinding.h"
 #include "Map.h"
-#include <queue>
-#include <unordered_map> 
+#include "Profiler.h"
+#include "BucketQueue.h"
 #include <algorithm>
 #include <vector>
-#include <random>
-
-// Verifica si una posición está ocupada por otro tanque
-// Qué sucede: Se verifica si algún tanque ocupa la posición especificada.
-// Por qué sucede: Para evitar colisiones y asegurarse de que el tanque no se mueva a una celda ocupada.
-// Qué deberíamos esperar: True si la celda está ocupada, false si no.
-bool isTankOccupied(int x, int y, const std::vector<Tank>& tanks) {
-    for (const Tank& tank : tanks) {
-        if (tank.getX() == x && tank.getY() == y) {
-            return true;
-        }
+#include <cstdlib>
+
+// Direcciones de expansión en el mismo orden que los algoritmos originales (abajo, derecha, arriba, izquierda)
+// Qué sucede: Cada entrada asocia un desplazamiento con su bit en la máscara de vecinos del mapa.
+// Por qué sucede: Es un arreglo estático, así que expandir vecinos no reserva memoria.
+struct Direction {
+    int dx;
+    int dy;
+    std::uint8_t bit;
+};
+
+static const Direction kDirections[4] = {
+    {0, 1, Map::NEIGHBOR_DOWN},
+    {1, 0, Map::NEIGHBOR_RIGHT},
+    {0, -1, Map::NEIGHBOR_UP},
+    {-1, 0, Map::NEIGHBOR_LEFT}
+};
+
+// Espacio de trabajo por hilo para las versiones sin workspace explícito
+// Qué sucede: Cada hilo reutiliza su propio espacio de trabajo entre llamadas.
+// Por qué sucede: Las firmas originales conservan su comportamiento sin volver a reservar memoria en cada consulta.
+static SearchWorkspace& defaultWorkspace() {
+    thread_local SearchWorkspace workspace;
+    return workspace;
+}
+
+// Reconstruir la ruta desde los padres del espacio de trabajo
+// Qué sucede: Sigue los índices de padre desde el destino hasta el inicio y devuelve las celdas en orden.
+// Por qué sucede: Todas las búsquedas guardan el padre de cada celda como índice lineal.
+static std::vector<Cell> reconstructPath(const Map& map, const SearchWorkspace& workspace, int endIndex) {
+    int size = map.getSize();
+    int length = 0;
+    for (int at = endIndex; at != -1; at = workspace.getParent(at)) {
+        ++length;
+    }
+
+    std::vector<Cell> path(length);
+    for (int at = endIndex; at != -1; at = workspace.getParent(at)) {
+        path[--length] = {at % size, at / size};
     }
-    return false;
+    return path;
+}
+
+// Comparador del heap: menor `f` primero y, ante empates, mayor `g`
+// Qué sucede: Preferir el nodo con mayor `g` (más cerca del destino) evita expandir toda la franja de rutas equivalentes.
+static bool heapCompare(const HeapEntry& a, const HeapEntry& b) {
+    if (a.f != b.f) return a.f > b.f;
+    return a.g < b.g;
+}
+
+static void heapPush(std::vector<HeapEntry>& heap, const HeapEntry& entry) {
+    heap.push_back(entry);
+    std::push_heap(heap.begin(), heap.end(), heapCompare);
+}
+
+static HeapEntry heapPop(std::vector<HeapEntry>& heap) {
+    std::pop_heap(heap.begin(), heap.end(), heapCompare);
+    HeapEntry top = heap.back();
+    heap.pop_back();
+    return top;
 }
 
 // Algoritmo de búsqueda en anchura (BFS) para encontrar una ruta
 // Qué sucede: Encuentra una ruta más corta desde la posición inicial hasta la posición final.
 // Por qué sucede: BFS se utiliza porque garantiza la ruta más corta en un grafo no ponderado.
 // Qué deberíamos esperar: Una lista de celdas que representan la ruta encontrada.
-std::vector<Cell> bfs(const Map& map, int startX, int startY, int endX, int endY, const std::vector<Tank>& tanks) {
-    std::queue<Cell> q;
-    q.push({startX, startY});
+std::vector<Cell> bfs(const Map& map, int startX, int startY, int endX, int endY, const OccupancyGrid& occupancy) {
+    return bfs(map, startX, startY, endX, endY, occupancy, defaultWorkspace());
+}
 
-    std::unordered_map<int, Cell> parent;
-    parent[startY * map.getSize() + startX] = {-1, -1};
+std::vector<Cell> bfs(const Map& map, int startX, int startY, int endX, int endY, const OccupancyGrid& occupancy,
+                      SearchWorkspace& workspace) {
+    PROFILE_SCOPE("bfs");
+    if (!map.isReachable(startX, startY, endX, endY)) {
+        return {};  // Componentes distintas: no hay ruta y no hace falta explorar
+    }
+    int size = map.getSize();
+    workspace.beginSearch(size);
+    std::vector<int>& q = workspace.queueBuffer();
 
-    std::vector<Cell> directions = {{0, 1}, {1, 0}, {0, -1}, {-1, 0}}; // Direcciones posibles
+    int startIndex = map.cellIndex(startX, startY);
+    int endIndex = map.cellIndex(endX, endY);
+    workspace.visit(startIndex, -1, 0);
+    q.push_back(startIndex);
 
-    while (!q.empty()) {
-        Cell current = q.front();
-        q.pop();
+    for (size_t head = 0; head < q.size(); ++head) {
+        int current = q[head];
 
         // Construir la ruta si se llega al destino
-        if (current.x == endX && current.y == endY) {
-            std::vector<Cell> path;
-            for (Cell at = {endX, endY}; at.x != -1 && at.y != -1; at = parent[at.y * map.getSize() + at.x]) {
-                path.push_back(at);
-            }
-            std::reverse(path.begin(), path.end());
-            return path;
+        if (current == endIndex) {
+            return reconstructPath(map, workspace, endIndex);
         }
 
-        // Revisar celdas adyacentes
-        for (const Cell& dir : directions) {
-            int newX = current.x + dir.x;
-            int newY = current.y + dir.y;
+        // Revisar celdas adyacentes usando la máscara de vecinos del mapa
+        int x = current % size;
+        int y = current / size;
+        std::uint8_t mask = map.getNeighborMask(x, y);
+        for (const Direction& dir : kDirections) {
+            if (!(mask & dir.bit)) {
+                continue;
+            }
+            int newX = x + dir.dx;
+            int newY = y + dir.dy;
+            int newIndex = current + dir.dy * size + dir.dx;
 
-            if (map.isValidPosition(newX, newY) && parent.find(newY * map.getSize() + newX) == parent.end() &&
-                !isTankOccupied(newX, newY, tanks)) {
-                q.push({newX, newY});
-                parent[newY * map.getSize() + newX] = current;
+            if (!workspace.isVisited(newIndex) && !occupancy.isOccupied(newX, newY)) {
+                workspace.visit(newIndex, current, 0);
+                q.push_back(newIndex);
             }
         }
     }
@@ -67,15 +124,19 @@ std::vector<Cell> bfs(const Map& map, int startX, int startY, int endX, int endY
 // Qué sucede: Elige aleatoriamente una dirección válida para mover el tanque.
 // Por qué sucede: Simula un movimiento aleatorio cuando no se usa un algoritmo de búsqueda de caminos.
 // Qué deberíamos esperar: Una ruta que incluye la posición inicial y la nueva posición a la que se mueve el tanque.
-std::vector<Cell> moveRandomly(int startX, int startY, const Map& map, const std::vector<Tank>& tanks) {
-    std::vector<Cell> directions = {{0, 1}, {1, 0}, {0, -1}, {-1, 0}};
-    std::shuffle(directions.begin(), directions.end(), std::mt19937{std::random_device{}()});
+//                         Las direcciones se mezclan con Fisher-Yates usando `rng`, sin crear un `std::random_device`
+//                         (una llamada al sistema) en cada movimiento y con el mismo resultado en cualquier plataforma.
+std::vector<Cell> moveRandomly(int startX, int startY, const Map& map, const OccupancyGrid& occupancy, Rng& rng) {
+    Cell directions[4] = {{0, 1}, {1, 0}, {0, -1}, {-1, 0}};
+    for (int i = 3; i > 0; --i) {
+        std::swap(directions[i], directions[rng.below(i + 1)]);
+    }
 
     for (const Cell& dir : directions) {
         int newX = startX + dir.x;
         int newY = startY + dir.y;
 
-        if (map.isValidPosition(newX, newY) && !isTankOccupied(newX, newY, tanks)) {
+        if (map.isValidPosition(newX, newY) && !occupancy.isOccupied(newX, newY)) {
             return {{startX, startY}, {newX, newY}};
         }
     }
@@ -84,56 +145,311 @@ std::vector<Cell> moveRandomly(int startX, int startY, const Map& map, const std
 }
 
 // Algoritmo de Dijkstra para encontrar la ruta de menor costo
-// Qué sucede: Encuentra la ruta de menor costo en un grafo ponderado.
+// Qué sucede: Encuentra la ruta de menor costo en un grafo ponderado: entrar a una celda cuesta `Map::getMoveCost`.
+//             La frontera es una cola por cubetas (algoritmo de Dial), porque los costos son enteros de 1 a
+//             `Map::MAX_MOVE_COST`.
 // Por qué sucede: Dijkstra es útil para encontrar la ruta más eficiente en mapas con diferentes tipos de terreno.
+//                 Con un heap binario cada inserción y extracción costaba O(log n) comparaciones.
 // Qué deberíamos esperar: Una lista de celdas que representan la ruta con el menor costo desde la posición inicial hasta la final.
-std::vector<Cell> dijkstra(const Map& map, int startX, int startY, int endX, int endY, const std::vector<Tank>& tanks) {
-    using P = std::pair<int, Cell>;
+std::vector<Cell> dijkstra(const Map& map, int startX, int startY, int endX, int endY, const OccupancyGrid& occupancy) {
+    return dijkstra(map, startX, startY, endX, endY, occupancy, defaultWorkspace());
+}
+
+std::vector<Cell> dijkstra(const Map& map, int startX, int startY, int endX, int endY, const OccupancyGrid& occupancy,
+                           SearchWorkspace& workspace) {
+    PROFILE_SCOPE("dijkstra");
+    if (!map.isReachable(startX, startY, endX, endY)) {
+        return {};  // Componentes distintas: no hay ruta y no hace falta explorar
+    }
+    int size = map.getSize();
+    workspace.beginSearch(size);
+    BucketQueue& open = workspace.bucketQueue();
+    open.reset(Map::MAX_MOVE_COST);  // Cada paso suma entre 1 y `MAX_MOVE_COST` al costo que se expande
+
+    int startIndex = map.cellIndex(startX, startY);
+    int endIndex = map.cellIndex(endX, endY);
+    workspace.visit(startIndex, -1, 0);
+    open.push(0, startIndex);
+
+    while (!open.empty()) {
+        int g;
+        int current = open.pop(g);
+
+        // Ignorar entradas obsoletas de la cola (ya se encontró un costo menor)
+        if (g > workspace.getCost(current)) {
+            continue;
+        }
+
+        if (current == endIndex) {
+            return reconstructPath(map, workspace, endIndex);
+        }
+
+        int x = current % size;
+        int y = current / size;
+        std::uint8_t mask = map.getNeighborMask(x, y);
+        for (const Direction& dir : kDirections) {
+            if (!(mask & dir.bit)) {
+                continue;
+            }
+            int newX = x + dir.dx;
+            int newY = y + dir.dy;
+            int newIndex = current + dir.dy * size + dir.dx;
+
+            if (!occupancy.isOccupied(newX, newY)) {
+                int newCost = g + map.getMoveCost(newIndex);
+                if (!workspace.isVisited(newIndex) || newCost < workspace.getCost(newIndex)) {
+                    workspace.visit(newIndex, current, newCost);
+                    open.push(newCost, newIndex);
+                }
+            }
+        }
+    }
+
+    return {};
+}
+
+// Distancia Manhattan entre dos celdas
+// Qué sucede: Suma las diferencias absolutas en x e y.
+// Por qué sucede: Es la heurística admisible para una cuadrícula 4-conexa con costo 1 por movimiento; con terreno se
+//                 multiplica por el menor costo de un paso.
+static int manhattan(int x1, int y1, int x2, int y2) {
+    return std::abs(x1 - x2) + std::abs(y1 - y2);
+}
+
+// Algoritmo A* con heurística Manhattan
+// Qué sucede: Expande primero las celdas con menor costo estimado total hasta el destino, con los mismos costos de
+//             terreno y la misma cola por cubetas que Dijkstra. La heurística es la distancia Manhattan por
+//             `Map::getMinMoveCost`, que es consistente: la prioridad que se saca nunca baja.
+// Por qué sucede: Con una heurística admisible encuentra la ruta más corta sin inundar todo el mapa como BFS.
+// Qué deberíamos esperar: Una lista de celdas desde la posición inicial hasta la final, o vacía si no hay ruta.
+std::vector<Cell> aStar(const Map& map, int startX, int startY, int endX, int endY, const OccupancyGrid& occupancy) {
+    return aStar(map, startX, startY, endX, endY, occupancy, defaultWorkspace());
+}
+
+std::vector<Cell> aStar(const Map& map, int startX, int startY, int endX, int endY, const OccupancyGrid& occupancy,
+                        SearchWorkspace& workspace) {
+    PROFILE_SCOPE("a_star");
+    if (!map.isReachable(startX, startY, endX, endY)) {
+        return {};  // Componentes distintas: no hay ruta y no hace falta explorar
+    }
+    int size = map.getSize();
+    int minCost = map.getMinMoveCost();
+    workspace.beginSearch(size);
+    BucketQueue& open = workspace.bucketQueue();
+    // Un paso suma su costo a `g` y cambia la heurística en `minCost` como mucho
+    open.reset(Map::MAX_MOVE_COST + minCost);
+
+    int startIndex = map.cellIndex(startX, startY);
+    int endIndex = map.cellIndex(endX, endY);
+    workspace.visit(startIndex, -1, 0);
+    open.push(minCost * manhattan(startX, startY, endX, endY), startIndex);
+
+    while (!open.empty()) {
+        int f;
+        int current = open.pop(f);
+        int x = current % size;
+        int y = current / size;
+        int g = workspace.getCost(current);
+
+        // Ignorar entradas obsoletas de la cola (ya se encontró un costo menor)
+        if (f > g + minCost * manhattan(x, y, endX, endY)) {
+            continue;
+        }
+
+        if (current == endIndex) {
+            return reconstructPath(map, workspace, endIndex);
+        }
+
+        std::uint8_t mask = map.getNeighborMask(x, y);
+        for (const Direction& dir : kDirections) {
+            if (!(mask & dir.bit)) {
+                continue;
+            }
+            int newX = x + dir.dx;
+            int newY = y + dir.dy;
+            int newIndex = current + dir.dy * size + dir.dx;
+
+            if (!occupancy.isOccupied(newX, newY)) {
+                int newCost = g + map.getMoveCost(newIndex);
+                if (!workspace.isVisited(newIndex) || newCost < workspace.getCost(newIndex)) {
+                    workspace.visit(newIndex, current, newCost);
+                    open.push(newCost + minCost * manhattan(newX, newY, endX, endY), newIndex);
+                }
+            }
+        }
+    }
+
+    return {};
+}
+
+// Verifica si una celda bloquea el paso (fuera del mapa, obstáculo o tanque)
+// Qué sucede: Combina las comprobaciones de límites, obstáculos y ocupación por tanques.
+// Por qué sucede: Jump Point Search necesita consultar muchas celdas vecinas al buscar giros forzados.
+static bool isBlocked(const Map& map, int x, int y, const OccupancyGrid& occupancy) {
+    return !map.isValidPosition(x, y) || occupancy.isOccupied(x, y);
+}
+
+// Salto horizontal de Jump Point Search
+// Qué sucede: Avanza en la dirección `dx` hasta encontrar el destino o una celda con vecino vertical forzado
+//             (la celda de arriba/abajo se abre justo después de un obstáculo).
+// Por qué sucede: Solo en esos puntos una ruta óptima necesita girar; el resto del tramo es simétrico.
+// Qué deberíamos esperar: `true` y el punto de salto en `jumpPoint`, o `false` si el tramo termina en un bloqueo.
+static bool jumpHorizontal(const Map& map, int x, int y, int dx, int endX, int endY,
+                           const OccupancyGrid& occupancy, Cell& jumpPoint) {
+    while (true) {
+        x += dx;
+        if (isBlocked(map, x, y, occupancy)) {
+            return false;
+        }
+        if ((x == endX && y == endY) ||
+            (isBlocked(map, x - dx, y + 1, occupancy) && !isBlocked(map, x, y + 1, occupancy)) ||
+            (isBlocked(map, x - dx, y - 1, occupancy) && !isBlocked(map, x, y - 1, occupancy))) {
+            jumpPoint = {x, y};
+            return true;
+        }
+    }
+}
+
+// Salto vertical de Jump Point Search
+// Qué sucede: Avanza en la dirección `dy` y en cada celda lanza los saltos horizontales; si alguno encuentra
+//             un punto de salto, la celda actual también lo es.
+// Por qué sucede: Las rutas canónicas se mueven primero en vertical y luego en horizontal, así que los giros
+//                 desde un tramo vertical se descubren con los escaneos horizontales.
+// Qué deberíamos esperar: `true` y el punto de salto en `jumpPoint`, o `false` si el tramo termina en un bloqueo.
+static bool jumpVertical(const Map& map, int x, int y, int dy, int endX, int endY,
+                         const OccupancyGrid& occupancy, Cell& jumpPoint) {
+    Cell ignored;
+    while (true) {
+        y += dy;
+        if (isBlocked(map, x, y, occupancy)) {
+            return false;
+        }
+        if ((x == endX && y == endY) ||
+            jumpHorizontal(map, x, y, 1, endX, endY, occupancy, ignored) ||
+            jumpHorizontal(map, x, y, -1, endX, endY, occupancy, ignored)) {
+            jumpPoint = {x, y};
+            return true;
+        }
+    }
+}
 
-    auto compare = [](const P& a, const P& b) {
-        return a.first > b.first; 
-    };
-    std::priority_queue<P, std::vector<P>, decltype(compare)> pq(compare);
+// Jump Point Search para cuadrícula 4-conexa
+// Qué sucede: Ejecuta A* sobre los puntos de salto; los vecinos de cada punto se podan según la dirección de llegada.
+// Por qué sucede: Reduce los nodos expandidos en órdenes de magnitud en mapas abiertos con costo uniforme.
+// Qué deberíamos esperar: Una ruta óptima celda por celda, o vacía si no hay ruta.
+std::vector<Cell> jumpPointSearch(const Map& map, int startX, int startY, int endX, int endY, const OccupancyGrid& occupancy) {
+    return jumpPointSearch(map, startX, startY, endX, endY, occupancy, defaultWorkspace());
+}
 
-    std::unordered_map<int, int> cost;
-    std::unordered_map<int, Cell> parent;
+std::vector<Cell> jumpPointSearch(const Map& map, int startX, int startY, int endX, int endY, const OccupancyGrid& occupancy,
+                                  SearchWorkspace& workspace) {
+    PROFILE_SCOPE("jump_point_search");
+    if (!map.isReachable(startX, startY, endX, endY)) {
+        return {};  // Componentes distintas: no hay ruta y no hace falta explorar
+    }
+    int size = map.getSize();
+    workspace.beginSearch(size);
+    std::vector<HeapEntry>& open = workspace.heapBuffer();
 
-    int startKey = startY * map.getSize() + startX;
-    cost[startKey] = 0;
-    parent[startKey] = {-1, -1};
-    pq.push({0, {startX, startY}});
+    int startIndex = map.cellIndex(startX, startY);
+    int endIndex = map.cellIndex(endX, endY);
+    workspace.visit(startIndex, -1, 0);
+    heapPush(open, {manhattan(startX, startY, endX, endY), 0, startIndex});
 
-    std::vector<Cell> directions = {{0, 1}, {1, 0}, {0, -1}, {-1, 0}};
+    while (!open.empty()) {
+        HeapEntry current = heapPop(open);
+        if (current.g > workspace.getCost(current.index)) {
+            continue;
+        }
 
-    while (!pq.empty()) {
-        P current = pq.top();
-        pq.pop();
-        Cell currentCell = current.second;
+        Cell currentCell = {current.index % size, current.index / size};
 
-        if (currentCell.x == endX && currentCell.y == endY) {
+        if (current.index == endIndex) {
+            // Reconstruir la ruta rellenando los tramos rectos entre puntos de salto
+            std::vector<Cell> jumpPoints = reconstructPath(map, workspace, endIndex);
             std::vector<Cell> path;
-            for (Cell at = {endX, endY}; at.x != -1 && at.y != -1; at = parent[at.y * map.getSize() + at.x]) {
-                path.push_back(at);
+            path.reserve(current.g + 1);
+            path.push_back(jumpPoints.front());
+            for (size_t i = 1; i < jumpPoints.size(); ++i) {
+                Cell from = jumpPoints[i - 1];
+                Cell to = jumpPoints[i];
+                int stepX = (to.x > from.x) - (to.x < from.x);
+                int stepY = (to.y > from.y) - (to.y < from.y);
+                while (from.x != to.x || from.y != to.y) {
+                    from.x += stepX;
+                    from.y += stepY;
+                    path.push_back(from);
+                }
             }
-            std::reverse(path.begin(), path.end());
             return path;
         }
 
-        for (const Cell& dir : directions) {
-            int newX = currentCell.x + dir.x;
-            int newY = currentCell.y + dir.y;
-            int newKey = newY * map.getSize() + newX;
+        // Poda de vecinos según la dirección de llegada
+        // Qué sucede: Desde el inicio se exploran las 4 direcciones; tras un tramo vertical se continúa en vertical
+        //             y se abren ambos lados; tras un tramo horizontal se continúa y solo se gira si es forzado.
+        int parentIndex = workspace.getParent(current.index);
+        int dx = 0, dy = 0;
+        if (parentIndex != -1) {
+            int parentX = parentIndex % size;
+            int parentY = parentIndex / size;
+            dx = (currentCell.x > parentX) - (currentCell.x < parentX);
+            dy = (currentCell.y > parentY) - (currentCell.y < parentY);
+        }
 
-            if (map.isValidPosition(newX, newY) && !isTankOccupied(newX, newY, tanks)) {
-                int newCost = cost[currentCell.y * map.getSize() + currentCell.x] + 1;
-                if (cost.find(newKey) == cost.end() || newCost < cost[newKey]) {
-                    cost[newKey] = newCost;
-                    parent[newKey] = currentCell;
-                    pq.push({newCost, {newX, newY}});
-                }
+        Cell candidates[4];
+        int candidateCount = 0;
+        Cell jumpPoint;
+        auto tryVertical = [&](int dirY) {
+            if (jumpVertical(map, currentCell.x, currentCell.y, dirY, endX, endY, occupancy, jumpPoint)) {
+                candidates[candidateCount++] = jumpPoint;
+            }
+        };
+        auto tryHorizontal = [&](int dirX) {
+            if (jumpHorizontal(map, currentCell.x, currentCell.y, dirX, endX, endY, occupancy, jumpPoint)) {
+                candidates[candidateCount++] = jumpPoint;
+            }
+        };
+
+        if (dx == 0 && dy == 0) {
+            tryVertical(1);
+            tryVertical(-1);
+            tryHorizontal(1);
+            tryHorizontal(-1);
+        } else if (dy != 0) {
+            tryVertical(dy);
+            tryHorizontal(1);
+            tryHorizontal(-1);
+        } else {
+            tryHorizontal(dx);
+            int x = currentCell.x;
+            int y = currentCell.y;
+            if (isBlocked(map, x - dx, y + 1, occupancy) && !isBlocked(map, x, y + 1, occupancy)) tryVertical(1);
+            if (isBlocked(map, x - dx, y - 1, occupancy) && !isBlocked(map, x, y - 1, occupancy)) tryVertical(-1);
+        }
+
+        for (int i = 0; i < candidateCount; ++i) {
+            Cell next = candidates[i];
+            int newIndex = map.cellIndex(next.x, next.y);
+            int newCost = current.g + manhattan(currentCell.x, currentCell.y, next.x, next.y);
+            if (!workspace.isVisited(newIndex) || newCost < workspace.getCost(newIndex)) {
+                workspace.visit(newIndex, current.index, newCost);
+                heapPush(open, {newCost + manhattan(next.x, next.y, endX, endY), newCost, newIndex});
             }
         }
     }
 
     return {};
 }
+
+// Ejecutar el algoritmo indicado
+// Qué sucede: Despacha la consulta al algoritmo elegido usando el mismo espacio de trabajo.
+std::vector<Cell> findPath(PathAlgorithm algorithm, const Map& map, int startX, int startY, int endX, int endY,
+                           const OccupancyGrid& occupancy, SearchWorkspace& workspace) {
+    switch (algorithm) {
+        case PATH_BFS:      return bfs(map, startX, startY, endX, endY, occupancy, workspace);
+        case PATH_DIJKSTRA: return dijkstra(map, startX, startY, endX, endY, occupancy, workspace);
+        case PATH_ASTAR:    return aStar(map, startX, startY, endX, endY, occupancy, workspace);
+        case PATH_JPS:      return jumpPointSearch(map, startX, startY, endX, endY, occupancy, workspace);
+    }
+    return {};
+}
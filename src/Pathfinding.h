@@ -2,7 +2,9 @@
 #define PATHFINDING_H
 
 #include "Map.h"
-#include "Tank.h"
+#include "OccupancyGrid.h"
+#include "SearchWorkspace.h"
+#include "Rng.h"
 #include <vector>
 
 // Estructura que representa una celda del mapa
@@ -18,12 +20,60 @@ struct Cell {
     Cell(int x_, int y_) : x(x_), y(y_) {}
 };
 
+// Algoritmos de búsqueda disponibles
+// Qué sucede: Identifica cada algoritmo para poder elegirlo en tiempo de ejecución.
+// Por qué sucede: La caché de rutas y las consultas por lotes guardan o reciben el algoritmo junto a la consulta.
+enum PathAlgorithm {
+    PATH_BFS,
+    PATH_DIJKSTRA,
+    PATH_ASTAR,
+    PATH_JPS
+};
+
 // Funciones de búsqueda de rutas
-// Qué sucede: Se definen tres funciones para mover tanques: BFS, movimiento aleatorio y Dijkstra.
+// Qué sucede: Se definen las funciones para mover tanques: BFS, movimiento aleatorio, Dijkstra, A* y Jump Point Search.
 // Por qué sucede: Cada uno de estos métodos tiene una utilidad específica para calcular la ruta de los tanques.
-// Qué deberíamos esperar: Diferentes comportamientos de movimiento según el algoritmo seleccionado.
-std::vector<Cell> bfs(const Map& map, int startX, int startY, int endX, int endY, const std::vector<Tank>& tanks);
-std::vector<Cell> moveRandomly(int startX, int startY, const Map& map, const std::vector<Tank>& tanks);
-std::vector<Cell> dijkstra(const Map& map, int startX, int startY, int endX, int endY, const std::vector<Tank>& tanks);
+// Qué deberíamos esperar: Diferentes comportamientos de movimiento según el algoritmo seleccionado. BFS y Jump Point
+//                         Search buscan la ruta con menos celdas; Dijkstra y A*, la de menor costo de terreno
+//                         (`Map::getMoveCost`).
+std::vector<Cell> bfs(const Map& map, int startX, int startY, int endX, int endY, const OccupancyGrid& occupancy);
+// `moveRandomly` usa el generador de la partida: la misma semilla produce el mismo movimiento.
+std::vector<Cell> moveRandomly(int startX, int startY, const Map& map, const OccupancyGrid& occupancy, Rng& rng);
+std::vector<Cell> dijkstra(const Map& map, int startX, int startY, int endX, int endY, const OccupancyGrid& occupancy);
+
+// Búsqueda A* con heurística Manhattan
+// Qué sucede: Igual que Dijkstra pero ordena la frontera por costo + distancia Manhattan al destino por el menor
+//             costo de un paso (`Map::getMinMoveCost`).
+// Por qué sucede: La heurística es admisible y dirige la búsqueda hacia el objetivo.
+// Qué deberíamos esperar: Una ruta del mismo costo que Dijkstra expandiendo muchas menos celdas.
+std::vector<Cell> aStar(const Map& map, int startX, int startY, int endX, int endY, const OccupancyGrid& occupancy);
+
+// Jump Point Search para la cuadrícula 4-conexa de costo uniforme (ignora el terreno)
+// Qué sucede: A* que solo inserta en la frontera los "puntos de salto" (giros forzados por obstáculos o tanques)
+//             y recorre los tramos rectos sin guardarlos; al final se rellenan los tramos celda por celda.
+// Por qué sucede: En mapas grandes y abiertos casi todas las celdas son simétricas y no necesitan expandirse.
+// Qué deberíamos esperar: La misma longitud de ruta que BFS, con la ruta completa celda por celda.
+std::vector<Cell> jumpPointSearch(const Map& map, int startX, int startY, int endX, int endY, const OccupancyGrid& occupancy);
+
+// Sobrecargas con espacio de trabajo explícito
+// Qué sucede: Las mismas búsquedas, pero usando los arreglos planos y buffers de `workspace` en lugar de tablas nuevas.
+// Por qué sucede: Quien hace muchas consultas (IA, lotes, hilos) reutiliza su workspace y no reserva memoria por búsqueda.
+// Qué deberíamos esperar: El mismo resultado que las versiones sin workspace; solo se reserva el vector de la ruta devuelta.
+//                         Si inicio y destino están en componentes distintas (`Map::isReachable`), todas devuelven
+//                         una ruta vacía en O(1), sin explorar.
+std::vector<Cell> bfs(const Map& map, int startX, int startY, int endX, int endY, const OccupancyGrid& occupancy,
+                      SearchWorkspace& workspace);
+std::vector<Cell> dijkstra(const Map& map, int startX, int startY, int endX, int endY, const OccupancyGrid& occupancy,
+                           SearchWorkspace& workspace);
+std::vector<Cell> aStar(const Map& map, int startX, int startY, int endX, int endY, const OccupancyGrid& occupancy,
+                        SearchWorkspace& workspace);
+std::vector<Cell> jumpPointSearch(const Map& map, int startX, int startY, int endX, int endY, const OccupancyGrid& occupancy,
+                                  SearchWorkspace& workspace);
+
+// Ejecutar el algoritmo indicado
+// Qué sucede: Llama a `bfs`, `dijkstra`, `aStar` o `jumpPointSearch` según `algorithm`.
+// Por qué sucede: Evita repetir el mismo `switch` en cada lugar que elige el algoritmo en tiempo de ejecución.
+std::vector<Cell> findPath(PathAlgorithm algorithm, const Map& map, int startX, int startY, int endX, int endY,
+                           const OccupancyGrid& occupancy, SearchWorkspace& workspace);
 
 #endif
@@ -0,0 +1,108 @@
+#include "Profiler.h"
+#include <chrono>
+#include <cstring>
+
+// Índice del hilo actual para las mediciones
+// Qué sucede: Cada hilo recibe un número consecutivo la primera vez que registra algo.
+static std::uint32_t currentThreadIndex() {
+    static std::atomic<std::uint32_t> nextThread{0};
+    thread_local std::uint32_t index = nextThread.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+// Origen del reloj del perfilador
+static std::chrono::steady_clock::time_point profilerEpoch() {
+    static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    return epoch;
+}
+
+Profiler::Profiler() : slots(new Slot[CAPACITY]), writeIndex(0) {
+    profilerEpoch();
+}
+
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+std::uint64_t Profiler::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - profilerEpoch())
+        .count();
+}
+
+// Guardar una medición
+// Qué sucede: Reserva una posición con `fetch_add`, la marca como incompleta, escribe los campos y publica la
+//             secuencia con `release`.
+void Profiler::record(const char* name, std::uint64_t startNs, std::uint64_t endNs) {
+    std::uint64_t index = writeIndex.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = slots[index & (CAPACITY - 1)];
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.startNs.store(startNs, std::memory_order_relaxed);
+    slot.durationNs.store(endNs - startNs, std::memory_order_relaxed);
+    slot.thread.store(currentThreadIndex(), std::memory_order_relaxed);
+    slot.sequence.store(index + 1, std::memory_order_release);
+}
+
+// Copiar las mediciones desde una marca
+// Qué sucede: Lee cada posición entre dos lecturas de su secuencia; si cambió o no coincide con el índice esperado,
+//             la posición se estaba sobrescribiendo y se descarta.
+void Profiler::collect(std::uint64_t fromIndex, std::vector<ProfileEvent>& events) const {
+    std::uint64_t end = getWriteIndex();
+    if (end - fromIndex > CAPACITY || fromIndex > end) {
+        fromIndex = end > CAPACITY ? end - CAPACITY : 0;
+    }
+    for (std::uint64_t index = fromIndex; index < end; ++index) {
+        const Slot& slot = slots[index & (CAPACITY - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != index + 1) {
+            continue;
+        }
+        ProfileEvent event;
+        event.name = slot.name.load(std::memory_order_relaxed);
+        event.startNs = slot.startNs.load(std::memory_order_relaxed);
+        event.durationNs = slot.durationNs.load(std::memory_order_relaxed);
+        event.thread = slot.thread.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) == index + 1) {
+            events.push_back(event);
+        }
+    }
+}
+
+// Escribir el búfer como `trace_event` de Chrome
+// Qué sucede: Cada medición es un evento completo (`"ph": "X"`) con inicio y duración en microsegundos.
+void Profiler::writeChromeTrace(std::ostream& out) const {
+    std::vector<ProfileEvent> events;
+    collect(0, events);
+
+    out << "{\"traceEvents\": [\n";
+    for (std::size_t i = 0; i < events.size(); ++i) {
+        const ProfileEvent& event = events[i];
+        out << "  {\"name\": \"" << event.name << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << event.thread
+            << ", \"ts\": " << event.startNs / 1000.0 << ", \"dur\": " << event.durationNs / 1000.0 << "}"
+            << (i + 1 < events.size() ? "," : "") << "\n";
+    }
+    out << "], \"displayTimeUnit\": \"ms\"}\n";
+}
+
+std::vector<ProfileTotal> Profiler::summarize(const std::vector<ProfileEvent>& events) {
+    std::vector<ProfileTotal> totals;
+    for (const ProfileEvent& event : events) {
+        ProfileTotal* total = nullptr;
+        for (ProfileTotal& candidate : totals) {
+            // Un mismo literal puede tener direcciones distintas en cada archivo
+            if (candidate.name == event.name || std::strcmp(candidate.name, event.name) == 0) {
+                total = &candidate;
+                break;
+            }
+        }
+        if (total == nullptr) {
+            totals.push_back({event.name, 0.0, 0});
+            total = &totals.back();
+        }
+        total->milliseconds += event.durationNs / 1e6;
+        total->count++;
+    }
+    return totals;
+}
@@ -0,0 +1,111 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+// Medición de una sección del código
+// Qué sucede: `name` debe ser un literal de texto; solo se guarda el puntero.
+struct ProfileEvent {
+    const char* name;
+    std::uint64_t startNs;  // Inicio, en nanosegundos desde que arrancó el perfilador
+    std::uint64_t durationNs;
+    std::uint32_t thread;  // Índice del hilo que la registró (0 para el primero)
+};
+
+// Tiempo total de una sección dentro de un grupo de mediciones
+struct ProfileTotal {
+    const char* name;
+    double milliseconds;
+    int count;
+};
+
+// Perfilador por secciones con búfer circular sin bloqueos
+// Qué sucede: Cada `PROFILE_SCOPE` guarda su duración en un búfer circular de tamaño fijo. Los hilos reservan
+//             posiciones con un contador atómico y cada posición tiene un número de secuencia, así que escribir
+//             nunca bloquea y quien lee descarta las posiciones que se estaban sobrescribiendo.
+// Por qué sucede: Para saber si un frame lento se debe a los eventos, las rutas, las balas, el borrado de tanques o el
+//                 dibujo, incluso cuando las búsquedas corren en los hilos de `ThreadPool`.
+// Qué deberíamos esperar: Sin `TANKATTACK_PROFILE` (`make PROFILE=1`), `PROFILE_SCOPE` no genera código y el búfer
+//                         queda vacío. Con él, cada sección cuesta dos lecturas del reloj y una escritura.
+class Profiler {
+public:
+    static constexpr std::size_t CAPACITY = 1 << 16;  // Mediciones que se conservan (potencia de 2)
+
+    // `true` si el programa se compiló con `TANKATTACK_PROFILE`.
+    static constexpr bool compiledIn() {
+#ifdef TANKATTACK_PROFILE
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // Perfilador global del proceso.
+    static Profiler& instance();
+
+    // Nanosegundos desde que arrancó el perfilador (reloj monótono).
+    static std::uint64_t now();
+
+    // Guardar una medición; si el búfer está lleno se sobrescribe la más antigua.
+    void record(const char* name, std::uint64_t startNs, std::uint64_t endNs);
+
+    // Cantidad de mediciones registradas desde el inicio; sirve de marca para `collect`.
+    std::uint64_t getWriteIndex() const { return writeIndex.load(std::memory_order_acquire); }
+
+    // Copiar las mediciones registradas desde la marca `fromIndex`
+    // Qué deberíamos esperar: Solo las que siguen en el búfer y no se estaban sobrescribiendo al leer.
+    void collect(std::uint64_t fromIndex, std::vector<ProfileEvent>& events) const;
+
+    // Escribir todo el búfer en formato `trace_event` de Chrome (chrome://tracing o Perfetto).
+    void writeChromeTrace(std::ostream& out) const;
+
+    // Sumar las duraciones por nombre, en el orden en que aparece cada sección por primera vez.
+    static std::vector<ProfileTotal> summarize(const std::vector<ProfileEvent>& events);
+
+private:
+    // Posición del búfer: los campos son atómicos para que leer mientras otro hilo escribe no sea una carrera
+    struct Slot {
+        std::atomic<std::uint64_t> sequence{0};  // Índice de escritura + 1 cuando la posición está completa
+        std::atomic<const char*> name{nullptr};
+        std::atomic<std::uint64_t> startNs{0};
+        std::atomic<std::uint64_t> durationNs{0};
+        std::atomic<std::uint32_t> thread{0};
+    };
+
+    Profiler();
+
+    std::unique_ptr<Slot[]> slots;
+    std::atomic<std::uint64_t> writeIndex;
+};
+
+// Medición de un bloque (RAII)
+// Qué sucede: Toma la hora al construirse y registra la duración al destruirse.
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name) : name(name), startNs(Profiler::now()) {}
+    ~ProfileScope() { Profiler::instance().record(name, startNs, Profiler::now()); }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name;
+    std::uint64_t startNs;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+// Medir el bloque actual con el nombre `name` (un literal de texto)
+#ifdef TANKATTACK_PROFILE
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,159 @@
+#include "Renderer.h"
+#include "Profiler.h"
+#include <cstdio>
+
+// Constructor
+// Qué sucede: Se inicializan los elementos de texto para mostrar el estado del juego.
+// Por qué sucede: Se proporciona retroalimentación visual a los jugadores (turnos y tiempo).
+Renderer::Renderer(sf::RenderWindow& window, int mapSize, int cellSize) : window(window), cellSize(cellSize), terrain(cellSize) {
+    turnText.setCharacterSize(24);
+    turnText.setFillColor(sf::Color::Black);
+    turnText.setPosition(10, mapSize * cellSize);
+
+    globalTimerText.setCharacterSize(24);
+    globalTimerText.setFillColor(sf::Color::Black);
+    globalTimerText.setPosition(window.getSize().x - 180, mapSize * cellSize);
+
+    powerUpText.setCharacterSize(24);
+    powerUpText.setFillColor(sf::Color::Black);
+    powerUpText.setPosition(10, mapSize * cellSize + 25);
+
+    profileText.setCharacterSize(12);
+    profileText.setFillColor(sf::Color::White);
+    profileText.setPosition(4, 4);
+}
+
+bool Renderer::loadFont(const std::string& path) {
+    if (!font.loadFromFile(path)) {
+        return false;
+    }
+    turnText.setFont(font);
+    globalTimerText.setFont(font);
+    powerUpText.setFont(font);
+    profileText.setFont(font);
+    return true;
+}
+
+// Dibujar un frame
+// Qué sucede: El terreno es una llamada a `draw`; tanques, barras de vida, ruta y balas se agregan al lote en el orden
+//             de dibujo y se envían juntos en otra llamada; después se dibujan los textos.
+void Renderer::draw(const GameState& state, float alpha) {
+    // Limpiar la ventana antes de dibujar el siguiente frame
+    window.clear(sf::Color::White);
+
+    // Dibujar el terreno (se recalcula solo si el mapa cambió)
+    {
+        PROFILE_SCOPE("draw_terrain");
+        terrain.update(state.getMap());
+        terrain.draw(window);
+    }
+
+    // Tanques, ruta planificada en verde y balas activas
+    {
+        PROFILE_SCOPE("draw_sprites");
+        sprites.clear();
+        for (const Tank& tank : state.getTanks()) {
+            addTank(tank, alpha);
+        }
+        addPath(state.getCurrentPath());
+        addBullets(state.getBullets(), alpha);
+        sprites.draw(window);
+    }
+
+    // Dibujar el texto del turno, el temporizador global y el power-up actual
+    PROFILE_SCOPE("draw_hud");
+    drawHud(state);
+}
+
+// Dibujar el resumen del perfilador
+// Qué sucede: Escribe en la esquina superior izquierda, sobre un fondo semitransparente, el tiempo de cada sección
+//             medida en el frame anterior.
+void Renderer::drawProfile(const std::vector<ProfileTotal>& totals) {
+    std::string text;
+    for (const ProfileTotal& total : totals) {
+        char line[96];
+        std::snprintf(line, sizeof(line), "%-18s %7.3f ms  x%d\n", total.name, total.milliseconds, total.count);
+        text += line;
+    }
+    profileText.setString(text);
+
+    sf::FloatRect bounds = profileText.getGlobalBounds();
+    sf::RectangleShape background(sf::Vector2f(bounds.left + bounds.width + 8, bounds.top + bounds.height + 8));
+    background.setFillColor(sf::Color(0, 0, 0, 160));
+    window.draw(background);
+    window.draw(profileText);
+}
+
+// Agregar un tanque al lote
+// Qué sucede: Agrega el tanque y su barra de vida entre la posición del tick anterior y la actual.
+// Qué deberíamos esperar: El tanque dibujado en la posición correspondiente con su barra de vida.
+void Renderer::addTank(const Tank& tank, float alpha) {
+    float drawX = (tank.getPreviousX() + (tank.getX() - tank.getPreviousX()) * alpha) * cellSize;
+    float drawY = (tank.getPreviousY() + (tank.getY() - tank.getPreviousY()) * alpha) * cellSize;
+
+    sf::Color color;
+    switch (tank.getColor()) {
+        case Tank::BLUE:    color = sf::Color::Blue; break;
+        case Tank::RED:     color = sf::Color::Red; break;
+        case Tank::CYAN:    color = sf::Color::Cyan; break;
+        case Tank::YELLOW:  color = sf::Color::Yellow; break;
+    }
+    sprites.addRect(drawX, drawY, cellSize, cellSize, color);
+
+    // Barra de vida: fondo rojo y la parte verde proporcional a la vida
+    float healthPercentage = static_cast<float>(tank.getHealth()) / 100.0f;
+    sprites.addRect(drawX, drawY - 8, cellSize, 5, sf::Color::Red);
+    sprites.addRect(drawX, drawY - 8, cellSize * healthPercentage, 5, sf::Color::Green);
+}
+
+void Renderer::addPath(const std::vector<Cell>& path) {
+    for (const Cell& cell : path) {
+        sprites.addRect(cell.x * cellSize, cell.y * cellSize, cellSize, cellSize, sf::Color::Green);
+    }
+}
+
+// Agregar las balas activas al lote
+// Qué sucede: Cada bala es un círculo negro de radio `cellSize / 6` con la esquina en su posición, como antes.
+void Renderer::addBullets(const BulletSystem& bullets, float alpha) {
+    float radius = cellSize / 6;  // Tamaño pequeño de la bala
+    for (std::size_t i = 0; i < bullets.getSlotCount(); ++i) {
+        if (bullets.isActive(i)) {
+            float x, y;
+            bullets.getPosition(i, alpha, x, y);
+            sprites.addCircle(x * cellSize + radius, y * cellSize + radius, radius, sf::Color::Black);
+        }
+    }
+}
+
+// Dibujar los textos del estado de la partida
+void Renderer::drawHud(const GameState& state) {
+    // Mostrar el power-up actual en la pantalla
+    int powerUp = state.getPowerUp(state.getCurrentPlayer());
+    if (powerUp != shownPowerUp) {
+        std::string powerUpName;
+        switch (powerUp) {
+            case DOUBLE_TURN: powerUpName = "Doble Turno"; break;
+            case MOVE_PRECISION: powerUpName = "Precisión de Movimiento"; break;
+            case ATTACK_PRECISION: powerUpName = "Precisión de Ataque"; break;
+            case ATTACK_POWER: powerUpName = "Poder de Ataque"; break;
+            default: powerUpName = "Ninguno"; break;
+        }
+        powerUpText.setString("Power-up: " + powerUpName);
+        shownPowerUp = powerUp;
+    }
+
+    // Actualizar el texto del turno y el temporizador global
+    int remainingTime = state.getRemainingSeconds();  // Tiempo restante en segundos
+    if (remainingTime != shownSeconds) {
+        globalTimerText.setString("Tiempo: " + std::to_string(remainingTime / 60) + ":" + std::to_string(remainingTime % 60));
+        shownSeconds = remainingTime;
+    }
+    if (state.getCurrentPlayer() != shownPlayer) {
+        turnText.setString("Turno del Jugador: " + std::to_string(state.getCurrentPlayer()));
+        shownPlayer = state.getCurrentPlayer();
+    }
+
+    window.draw(turnText);
+    window.draw(globalTimerText);
+    window.draw(powerUpText);
+}
@@ -0,0 +1,63 @@
+#ifndef RENDERER_H
+#define RENDERER_H
+
+#include <SFML/Graphics.hpp>
+#include "GameState.h"
+#include "TerrainLayer.h"
+#include "SpriteBatch.h"
+#include "Profiler.h"
+#include <string>
+#include <vector>
+
+// Dibujo de una partida con SFML
+// Qué sucede: Dibuja el mapa, los tanques, la ruta planificada, las balas y los textos del estado de la partida.
+// Por qué sucede: `Map`, `Tank` y las balas ya no dependen de `sf::RenderWindow`; todo el código de SFML del juego
+//                 queda en este archivo y en el bucle de `main`.
+// Qué deberíamos esperar: `draw` solo lee el `GameState`; dibujar o no dibujar no cambia la simulación.
+class Renderer {
+public:
+    // Constructor
+    // Qué sucede: Prepara los textos debajo del área de juego de `mapSize x mapSize` celdas.
+    Renderer(sf::RenderWindow& window, int mapSize, int cellSize);
+
+    // Cargar la fuente de los textos
+    // Qué deberíamos esperar: `false` si no se encuentra el archivo.
+    bool loadFont(const std::string& path);
+
+    // Dibujar un frame
+    // Qué sucede: Limpia la ventana y dibuja todo interpolando tanques y balas con `alpha` (0 a 1) entre el tick
+    //             anterior y el actual. No llama a `display`.
+    void draw(const GameState& state, float alpha);
+
+    // Dibujar el resumen del perfilador sobre el frame
+    // Qué sucede: Muestra el tiempo y la cantidad de cada sección de `totals`; se llama después de `draw`.
+    void drawProfile(const std::vector<ProfileTotal>& totals);
+
+    // Convertir una posición en píxeles a coordenadas de celda.
+    int toCell(int pixel) const { return pixel / cellSize; }
+
+private:
+    sf::RenderWindow& window;
+    int cellSize;  // Tamaño de cada celda (en píxeles)
+    TerrainLayer terrain;  // Terreno precalculado; se dibuja con una sola llamada
+    SpriteBatch sprites;  // Tanques, barras de vida, ruta y balas del frame; se dibujan con una sola llamada
+    sf::Font font;
+    sf::Text turnText;  // Turno del jugador actual
+    sf::Text globalTimerText;  // Tiempo restante de la partida
+    sf::Text powerUpText;  // Power-up del jugador actual
+    sf::Text profileText;  // Resumen del perfilador (solo con `drawProfile`)
+
+    // Últimos valores escritos en los textos
+    // Qué sucede: Los textos solo se rearman cuando cambia el valor que muestran (-1 fuerza la primera escritura).
+    // Por qué sucede: `setString` recalcula la geometría del texto; el reloj cambia una vez por segundo, no por frame.
+    int shownPlayer = -1;
+    int shownPowerUp = -1;
+    int shownSeconds = -1;
+
+    void addTank(const Tank& tank, float alpha);
+    void addPath(const std::vector<Cell>& path);
+    void addBullets(const BulletSystem& bullets, float alpha);
+    void drawHud(const GameState& state);
+};
+
+#endif
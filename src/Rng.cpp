@@ -0,0 +1,28 @@
+#include "Rng.h"
+
+// Paso de splitmix64
+// Qué sucede: Avanza `x` y devuelve un valor bien mezclado; se usa para expandir la semilla a los 256 bits de estado.
+static std::uint64_t splitMix64(std::uint64_t& x) {
+    std::uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+Rng::Rng(std::uint64_t seedValue) {
+    seed(seedValue);
+}
+
+// Reiniciar la secuencia
+// Qué sucede: splitmix64 nunca produce cuatro ceros seguidos, así que el estado siempre es válido para xoshiro.
+void Rng::seed(std::uint64_t seedValue) {
+    std::uint64_t x = seedValue;
+    for (std::uint64_t& word : state) {
+        word = splitMix64(x);
+    }
+}
+
+std::uint64_t Rng::deriveSeed(std::uint64_t base, std::uint64_t index) {
+    std::uint64_t x = base ^ (index * 0xD1B54A32D192ED03ULL);
+    return splitMix64(x);
+}
@@ -0,0 +1,64 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <cstdint>
+
+// Generador de números pseudoaleatorios por partida (xoshiro256**)
+// Qué sucede: Guarda 256 bits de estado que se inicializan a partir de una semilla de 64 bits con splitmix64.
+// Por qué sucede: `std::rand` es un estado global compartido por todos los hilos; cada partida necesita su propio
+//                 generador para correr en paralelo y para poder repetirse a partir de la semilla.
+// Qué deberíamos esperar: La misma semilla produce siempre la misma secuencia. Cumple los requisitos de
+//                         `UniformRandomBitGenerator`, así que sirve con `std::shuffle`.
+class Rng {
+public:
+    using result_type = std::uint64_t;
+
+    explicit Rng(std::uint64_t seed = 0);
+
+    // Reiniciar la secuencia a partir de una semilla.
+    void seed(std::uint64_t seed);
+
+    // Siguiente número de 64 bits
+    std::uint64_t next() {
+        const std::uint64_t result = rotl(state[1] * 5, 7) * 9;
+        const std::uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+    // Entero uniforme en `[0, bound)`
+    // Qué sucede: Multiplica por `bound` y toma la parte alta (método de Lemire), sin divisiones.
+    // Qué deberíamos esperar: 0 si `bound` es 0.
+    std::uint32_t below(std::uint32_t bound) {
+        return static_cast<std::uint32_t>(((next() >> 32) * bound) >> 32);
+    }
+
+    // Entero uniforme en `[min, max]` (ambos incluidos).
+    int range(int min, int max) {
+        return min + static_cast<int>(below(static_cast<std::uint32_t>(max - min + 1)));
+    }
+
+    // `true` con probabilidad `percent` / 100.
+    bool chance(int percent) { return static_cast<int>(below(100)) < percent; }
+
+    // Derivar una semilla independiente
+    // Qué sucede: Mezcla una semilla base con un índice (por ejemplo, el número de partida o de jugador).
+    // Por qué sucede: Cada partida de un lote obtiene su propia secuencia a partir de una sola semilla del lote.
+    static std::uint64_t deriveSeed(std::uint64_t base, std::uint64_t index);
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+    result_type operator()() { return next(); }
+
+private:
+    std::uint64_t state[4];
+
+    static std::uint64_t rotl(std::uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+};
+
+#endif
@@ -0,0 +1,37 @@
+#include "SearchWorkspace.h"
+#include <algorithm>
+
+// Constructor vacío
+// Qué sucede: Crea un espacio de trabajo sin arreglos; se dimensiona en la primera búsqueda.
+SearchWorkspace::SearchWorkspace() : generation(0), cells(0) {}
+
+// Constructor dimensionado para un mapa
+// Qué sucede: Reserva los arreglos para un mapa de `mapSize x mapSize` por adelantado.
+// Por qué sucede: Evita la reserva en la primera consulta cuando el tamaño del mapa ya se conoce.
+SearchWorkspace::SearchWorkspace(int mapSize) : generation(0), cells(0) {
+    beginSearch(mapSize);
+}
+
+// Preparar una nueva búsqueda
+// Qué sucede: Redimensiona si el mapa cambió de tamaño, vacía los buffers y avanza la generación.
+// Por qué sucede: Cambiar la generación invalida todas las marcas de visita sin recorrer los arreglos.
+// Qué deberíamos esperar: Si la generación da la vuelta a 0, las marcas se limpian una vez para evitar falsos positivos.
+void SearchWorkspace::beginSearch(int mapSize) {
+    int required = mapSize * mapSize;
+    if (required != cells) {
+        cells = required;
+        parent.assign(cells, -1);
+        cost.assign(cells, 0);
+        stamp.assign(cells, 0);
+        generation = 0;
+    }
+
+    ++generation;
+    if (generation == 0) {
+        std::fill(stamp.begin(), stamp.end(), 0);
+        generation = 1;
+    }
+
+    queue.clear();
+    heap.clear();
+}
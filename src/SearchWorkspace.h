@@ -0,0 +1,63 @@
+#ifndef SEARCH_WORKSPACE_H
+#define SEARCH_WORKSPACE_H
+
+#include "BucketQueue.h"
+#include <vector>
+#include <cstdint>
+
+// Entrada del heap usado por Jump Point Search
+// Qué sucede: Guarda la prioridad `f`, el costo acumulado `g` y el índice lineal de la celda.
+// Por qué sucede: Con índices enteros la cola no necesita construir objetos `Cell` ni tablas hash.
+struct HeapEntry {
+    int f;
+    int g;
+    int index;
+};
+
+// Espacio de trabajo reutilizable para las búsquedas de rutas
+// Qué sucede: Mantiene arreglos planos de padre y costo del tamaño del mapa, más los buffers de la cola FIFO, del
+//             heap y de la cola por cubetas.
+//             Cada celda lleva una marca de generación: una celda solo cuenta como visitada si su marca coincide
+//             con la generación de la búsqueda actual, así que no hay que limpiar nada entre consultas.
+// Por qué sucede: Las tablas `std::unordered_map` y las colas nuevas en cada búsqueda hacían que cada consulta
+//                 estuviera dominada por hashing y reservas de memoria.
+// Qué deberíamos esperar: Tras la primera búsqueda en un mapa, las siguientes no reservan memoria para su estado interno.
+class SearchWorkspace {
+public:
+    SearchWorkspace();
+    explicit SearchWorkspace(int mapSize);
+
+    // Preparar una nueva búsqueda
+    // Qué sucede: Ajusta los arreglos si cambió el tamaño del mapa y avanza la generación, invalidando las marcas previas.
+    // Por qué sucede: Es el único "reinicio" necesario entre consultas; es O(1) salvo al cambiar de tamaño.
+    void beginSearch(int mapSize);
+
+    // Consultar y actualizar el estado de una celda en la búsqueda actual
+    bool isVisited(int index) const { return stamp[index] == generation; }
+    void visit(int index, int parentIndex, int costValue) {
+        stamp[index] = generation;
+        parent[index] = parentIndex;
+        cost[index] = costValue;
+    }
+    int getParent(int index) const { return parent[index]; }
+    int getCost(int index) const { return cost[index]; }
+
+    // Buffers reutilizables de la frontera
+    // Qué sucede: Se vacían al iniciar cada búsqueda pero conservan su capacidad. La cola por cubetas la vacía cada
+    //             búsqueda con `BucketQueue::reset`, porque la cantidad de cubetas depende de sus costos.
+    std::vector<int>& queueBuffer() { return queue; }
+    std::vector<HeapEntry>& heapBuffer() { return heap; }
+    BucketQueue& bucketQueue() { return buckets; }
+
+private:
+    std::vector<int> parent;  // Índice de la celda padre en la búsqueda actual (-1 para el inicio)
+    std::vector<int> cost;  // Costo acumulado desde el inicio
+    std::vector<std::uint32_t> stamp;  // Generación en la que se visitó cada celda
+    std::vector<int> queue;  // Cola FIFO para BFS (se recorre con un índice de cabeza)
+    std::vector<HeapEntry> heap;  // Heap binario para JPS
+    BucketQueue buckets;  // Cola por cubetas para Dijkstra y A* (costos enteros chicos)
+    std::uint32_t generation;  // Generación de la búsqueda actual
+    int cells;  // Cantidad de celdas para la que están dimensionados los arreglos
+};
+
+#endif
@@ -0,0 +1,43 @@
+#include "SpriteBatch.h"
+#include <cmath>
+
+// Constructor
+// Qué sucede: Precalcula los puntos del círculo unitario para no llamar a `sin`/`cos` por cada bala.
+SpriteBatch::SpriteBatch() {
+    for (int i = 0; i <= CIRCLE_SEGMENTS; ++i) {
+        float angle = 2.0f * static_cast<float>(M_PI) * (i % CIRCLE_SEGMENTS) / CIRCLE_SEGMENTS;
+        unitCircle[i][0] = std::cos(angle);
+        unitCircle[i][1] = std::sin(angle);
+    }
+}
+
+void SpriteBatch::addRect(float x, float y, float width, float height, const sf::Color& color) {
+    sf::Vertex topLeft(sf::Vector2f(x, y), color);
+    sf::Vertex topRight(sf::Vector2f(x + width, y), color);
+    sf::Vertex bottomRight(sf::Vector2f(x + width, y + height), color);
+    sf::Vertex bottomLeft(sf::Vector2f(x, y + height), color);
+
+    vertices.push_back(topLeft);
+    vertices.push_back(topRight);
+    vertices.push_back(bottomRight);
+    vertices.push_back(topLeft);
+    vertices.push_back(bottomRight);
+    vertices.push_back(bottomLeft);
+}
+
+void SpriteBatch::addCircle(float centerX, float centerY, float radius, const sf::Color& color) {
+    sf::Vertex center(sf::Vector2f(centerX, centerY), color);
+    for (int i = 0; i < CIRCLE_SEGMENTS; ++i) {
+        vertices.push_back(center);
+        vertices.push_back(sf::Vertex(sf::Vector2f(centerX + unitCircle[i][0] * radius,
+                                                   centerY + unitCircle[i][1] * radius), color));
+        vertices.push_back(sf::Vertex(sf::Vector2f(centerX + unitCircle[i + 1][0] * radius,
+                                                   centerY + unitCircle[i + 1][1] * radius), color));
+    }
+}
+
+void SpriteBatch::draw(sf::RenderTarget& target) const {
+    if (!vertices.empty()) {
+        target.draw(vertices.data(), vertices.size(), sf::Triangles);
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef SPRITE_BATCH_H
+#define SPRITE_BATCH_H
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <cstddef>
+
+// Lote de figuras dinámicas
+// Qué sucede: Acumula rectángulos y círculos de color como triángulos en un único buffer de vértices que se reutiliza
+//             entre frames, y los envía a la ventana con una sola llamada a `draw`.
+// Por qué sucede: Crear un `sf::RectangleShape` o `sf::CircleShape` por tanque, barra de vida, celda de ruta y bala
+//                 costaba una llamada a `draw` por figura; con miles de entidades eso domina el frame.
+// Qué deberíamos esperar: Las figuras se dibujan en el orden en que se agregaron. `clear` vacía el lote pero conserva
+//                         la memoria reservada.
+class SpriteBatch {
+public:
+    SpriteBatch();
+
+    // Vaciar el lote para un nuevo frame.
+    void clear() { vertices.clear(); }
+
+    // Agregar un rectángulo con esquina superior izquierda en `(x, y)` (6 vértices).
+    void addRect(float x, float y, float width, float height, const sf::Color& color);
+
+    // Agregar un círculo de centro `(centerX, centerY)` aproximado con `CIRCLE_SEGMENTS` triángulos.
+    void addCircle(float centerX, float centerY, float radius, const sf::Color& color);
+
+    // Dibujar todo el lote con una sola llamada.
+    void draw(sf::RenderTarget& target) const;
+
+    std::size_t getVertexCount() const { return vertices.size(); }
+
+    static constexpr int CIRCLE_SEGMENTS = 12;
+
+private:
+    std::vector<sf::Vertex> vertices;  // Triángulos del frame actual
+    float unitCircle[CIRCLE_SEGMENTS + 1][2];  // Puntos del círculo unitario (el último repite el primero)
+};
+
+#endif
@@ -5,37 +5,37 @@
 // Por qué sucede: Permite crear un tanque con características específicas.
 // Qué deberíamos esperar: Un tanque ubicado en una posición dada con 100 de vida.
 Tank::Tank(Color color, int x, int y, int id) 
-    : x(x), y(y), color(color), health(100), id(id) {}
-
-// Dibujar el tanque en la ventana de juego
-// Qué sucede: Dibuja el tanque y su barra de vida en la ventana.
-// Por qué sucede: Para representar visualmente el tanque y su estado actual.
-// Qué deberíamos esperar: El tanque dibujado en la posición correspondiente con su barra de vida.
-void Tank::draw(sf::RenderWindow& window, int cellSize) const {
-    sf::RectangleShape tankShape(sf::Vector2f(cellSize, cellSize));
-    tankShape.setPosition(x * cellSize, y * cellSize);
-
-    switch (color) {
-        case BLUE:    tankShape.setFillColor(sf::Color::Blue); break;
-        case RED:     tankShape.setFillColor(sf::Color::Red); break;
-        case CYAN:    tankShape.setFillColor(sf::Color::Cyan); break;
-        case YELLOW:  tankShape.setFillColor(sf::Color::Yellow); break;
+    : x(x), y(y), previousX(x), previousY(y), color(color), health(100), id(id) {}
+
+// Cambiar la posición del tanque
+// Qué sucede: Actualiza la posición y, si el tanque está registrado, mueve su entrada en la capa de ocupación.
+// Por qué sucede: La capa de ocupación debe reflejar siempre dónde están los tanques.
+// Qué deberíamos esperar: `OccupancyGrid::tankAt` devuelve el ID del tanque en su nueva celda.
+void Tank::setPosition(int x, int y) {
+    if (occupancy != nullptr) {
+        occupancy->move(id, this->x, this->y, x, y);
     }
+    this->x = x;
+    this->y = y;
+}
 
-    window.draw(tankShape);
-
-    // Dibujar la barra de vida
-    sf::RectangleShape healthBarBackground(sf::Vector2f(cellSize, 5));
-    healthBarBackground.setPosition(x * cellSize, y * cellSize - 8);
-    healthBarBackground.setFillColor(sf::Color::Red);
-
-    float healthPercentage = static_cast<float>(health) / 100.0f;
-    sf::RectangleShape healthBar(sf::Vector2f(cellSize * healthPercentage, 5));
-    healthBar.setPosition(x * cellSize, y * cellSize - 8);
-    healthBar.setFillColor(sf::Color::Green);
+// Registrar el tanque en la capa de ocupación
+// Qué sucede: Guarda la capa y marca la celda actual del tanque como ocupada.
+void Tank::attachOccupancy(OccupancyGrid* grid) {
+    occupancy = grid;
+    if (occupancy != nullptr) {
+        occupancy->place(id, x, y);
+    }
+}
 
-    window.draw(healthBarBackground);
-    window.draw(healthBar);
+// Retirar el tanque de la capa de ocupación
+// Qué sucede: Libera la celda del tanque y deja de actualizar la capa.
+// Por qué sucede: Los tanques destruidos no deben bloquear celdas después de eliminarse.
+void Tank::detachOccupancy() {
+    if (occupancy != nullptr) {
+        occupancy->remove(id, x, y);
+        occupancy = nullptr;
+    }
 }
 
 // Aplicar daño al tanque
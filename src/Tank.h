@@ -1,7 +1,7 @@
 #ifndef TANK_H
 #define TANK_H
 
-#include <SFML/Graphics.hpp>
+#include "OccupancyGrid.h"
 
 // Clase Tank que representa un tanque en el juego
 class Tank {
@@ -14,25 +14,40 @@ public:
     };
 
     // Constructor y métodos del tanque
-    // Qué sucede: Definen cómo se comportan los tanques (mover, dibujar, recibir daño).
+    // Qué sucede: Definen cómo se comportan los tanques (mover, recibir daño); el dibujo lo hace `Renderer`.
     // Por qué sucede: Necesitamos representar la funcionalidad básica del tanque en el juego.
-    // Qué deberíamos esperar: Un tanque que puede moverse, recibir daño y dibujarse en pantalla.
+    // Qué deberíamos esperar: Un tanque que puede moverse y recibir daño, sin depender de SFML.
     Tank(Color color, int x, int y, int id);
     int getX() const { return x; }
     int getY() const { return y; }
-    void setPosition(int x, int y) { this->x = x; this->y = y; }
+    void setPosition(int x, int y);
     Color getColor() const { return color; }
     int getHealth() const { return health; }
-    void draw(sf::RenderWindow &window, int cellSize) const;
     void takeDamage(int damage);
     bool isDestroyed() const;
     int getId() const { return id; }
 
+    // Registro en la capa de ocupación
+    // Qué sucede: `attachOccupancy` coloca el tanque en la capa y hace que `setPosition` la mantenga al día;
+    //             `detachOccupancy` libera su celda al retirarlo del juego.
+    // Por qué sucede: La ocupación se consulta en O(1) desde la capa en lugar de recorrer todos los tanques.
+    void attachOccupancy(OccupancyGrid* grid);
+    void detachOccupancy();
+
+    // Guardar la posición al empezar un tick
+    // Qué sucede: La posición actual pasa a ser la anterior; el dibujo interpola entre ambas.
+    // Por qué sucede: La simulación avanza en ticks fijos y los frames caen entre dos ticks.
+    void storePreviousPosition() { previousX = x; previousY = y; }
+    int getPreviousX() const { return previousX; }
+    int getPreviousY() const { return previousY; }
+
 private:
     int x, y;  // Posición del tanque en el mapa
+    int previousX, previousY;  // Posición al empezar el tick actual (para interpolar el dibujo)
     Color color;  // Color del tanque
     int health;  // Vida del tanque (100 por defecto)
     int id;  // ID único del tanque
+    OccupancyGrid* occupancy = nullptr;  // Capa de ocupación donde está registrado (puede ser nula)
 };
 
 #endif
@@ -0,0 +1,84 @@
+#include "TerrainLayer.h"
+
+// Color de una celda
+// Qué sucede: Obstáculos en negro y celdas libres según su terreno: llano blanco, camino gris claro, barro marrón y
+//             escombros gris oscuro.
+static sf::Color cellColor(const Map& map, int x, int y) {
+    if (map.isObstacle(x, y)) {
+        return sf::Color::Black;
+    }
+    switch (map.getTerrain(x, y)) {
+        case Map::TERRAIN_ROAD:   return sf::Color(200, 200, 200);
+        case Map::TERRAIN_MUD:    return sf::Color(139, 100, 60);
+        case Map::TERRAIN_RUBBLE: return sf::Color(120, 120, 120);
+        default:                  return sf::Color::White;
+    }
+}
+
+TerrainLayer::TerrainLayer(int cellSize)
+    : cellSize(cellSize), mapSize(0), mapVersion(0), vertices(sf::Quads), rebuilds(0) {}
+
+// Actualizar los vértices
+// Qué sucede: Si cambió el tamaño o el historial de cambios ya no cubre la versión guardada, se reconstruye todo;
+//             si no, solo se recolorean las celdas que cambiaron con `Map::setObstacle` o `Map::setTerrain`.
+void TerrainLayer::update(const Map& map) {
+    if (map.getSize() == mapSize && map.getVersion() == mapVersion) {
+        return;
+    }
+
+    changedCells.clear();
+    if (map.getSize() != mapSize || !map.changedCellsSince(mapVersion, changedCells)) {
+        rebuild(map);
+        return;
+    }
+
+    for (int cell : changedCells) {
+        int x = cell % mapSize;
+        int y = cell / mapSize;
+        setCellColor(cell, cellColor(map, x, y));
+    }
+    mapVersion = map.getVersion();
+}
+
+// Reconstruir toda la capa
+// Qué sucede: El fondo negro forma las líneas de la grilla y los obstáculos; cada celda es un cuadrado con 1 píxel
+//             de margen.
+void TerrainLayer::rebuild(const Map& map) {
+    mapSize = map.getSize();
+    mapVersion = map.getVersion();
+    ++rebuilds;
+
+    const float total = static_cast<float>(mapSize * cellSize);
+    vertices.resize(4 + static_cast<std::size_t>(mapSize) * mapSize * 4);
+    vertices[0] = sf::Vertex(sf::Vector2f(0, 0), sf::Color::Black);
+    vertices[1] = sf::Vertex(sf::Vector2f(total, 0), sf::Color::Black);
+    vertices[2] = sf::Vertex(sf::Vector2f(total, total), sf::Color::Black);
+    vertices[3] = sf::Vertex(sf::Vector2f(0, total), sf::Color::Black);
+
+    for (int y = 0; y < mapSize; ++y) {
+        for (int x = 0; x < mapSize; ++x) {
+            int cell = map.cellIndex(x, y);
+            sf::Vertex* quad = &vertices[4 + static_cast<std::size_t>(cell) * 4];
+            float left = static_cast<float>(x * cellSize + 1);
+            float top = static_cast<float>(y * cellSize + 1);
+            float right = static_cast<float>((x + 1) * cellSize - 1);
+            float bottom = static_cast<float>((y + 1) * cellSize - 1);
+            quad[0].position = sf::Vector2f(left, top);
+            quad[1].position = sf::Vector2f(right, top);
+            quad[2].position = sf::Vector2f(right, bottom);
+            quad[3].position = sf::Vector2f(left, bottom);
+            setCellColor(cell, cellColor(map, x, y));
+        }
+    }
+}
+
+void TerrainLayer::setCellColor(int cell, const sf::Color& color) {
+    sf::Vertex* quad = &vertices[4 + static_cast<std::size_t>(cell) * 4];
+    for (int i = 0; i < 4; ++i) {
+        quad[i].color = color;
+    }
+}
+
+void TerrainLayer::draw(sf::RenderTarget& target) const {
+    target.draw(vertices);
+}
@@ -0,0 +1,42 @@
+#ifndef TERRAIN_LAYER_H
+#define TERRAIN_LAYER_H
+
+#include <SFML/Graphics.hpp>
+#include "Map.h"
+#include <vector>
+#include <cstdint>
+
+// Capa de terreno precalculada
+// Qué sucede: Guarda todo el terreno en un solo `sf::VertexArray`: un cuadrado negro de fondo y un cuadrado por celda,
+//             negro si es obstáculo y del color de su terreno si es libre, separado 1 píxel de sus vecinos para dejar
+//             ver la grilla.
+// Por qué sucede: Dibujar una figura por celda eran `size * size` llamadas a `draw` por frame aunque el terreno no
+//                 cambiara; así el terreno cuesta una sola llamada sin importar el tamaño del mapa.
+// Qué deberíamos esperar: Los vértices se recalculan solo si cambió la versión del mapa. Si el registro de cambios
+//                         cubre esa versión, solo se recolorean las celdas modificadas.
+class TerrainLayer {
+public:
+    explicit TerrainLayer(int cellSize);
+
+    // Actualizar los vértices si el mapa cambió desde la última llamada.
+    void update(const Map& map);
+
+    // Dibujar el terreno con una sola llamada.
+    void draw(sf::RenderTarget& target) const;
+
+    // Cantidad de veces que se reconstruyó toda la capa (útil para medir).
+    int getRebuildCount() const { return rebuilds; }
+
+private:
+    int cellSize;  // Tamaño de cada celda (en píxeles)
+    int mapSize;  // Tamaño del mapa con el que se construyó, 0 si todavía no se construyó
+    std::uint64_t mapVersion;  // Versión del mapa de los vértices actuales
+    sf::VertexArray vertices;  // Fondo (4 vértices) y luego 4 vértices por celda, fila por fila
+    std::vector<int> changedCells;  // Buffer reutilizable para las celdas cambiadas
+    int rebuilds;
+
+    void rebuild(const Map& map);
+    void setCellColor(int cell, const sf::Color& color);
+};
+
+#endif
@@ -0,0 +1,118 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+// Constructor del pool
+// Qué sucede: Crea una cola por hilo y lanza los hilos trabajadores.
+ThreadPool::ThreadPool(int threadCount) : queued(0), nextQueue(0), stopping(false) {
+    if (threadCount <= 0) {
+        threadCount = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    for (int i = 0; i < threadCount; ++i) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (int i = 0; i < threadCount; ++i) {
+        threads.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+// Destructor del pool
+// Qué sucede: Marca el cierre, despierta a todos y espera; los hilos vacían sus colas antes de salir.
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+// Encolar una tarea
+// Qué sucede: El contador se incrementa bajo el mismo mutex que usa la espera, así no se pierden despertares.
+void ThreadPool::submit(Task task) {
+    unsigned target = nextQueue.fetch_add(1) % queues.size();
+    {
+        std::lock_guard<std::mutex> lock(queues[target]->mutex);
+        queues[target]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        ++queued;
+    }
+    wake.notify_one();
+}
+
+// Tomar una tarea
+// Qué sucede: Primero el final de la cola propia (trabajo más reciente, mejor localidad); si está vacía, roba el
+//             principio de las colas de los demás hilos.
+bool ThreadPool::tryTake(int worker, Task& task) {
+    int count = static_cast<int>(queues.size());
+    for (int offset = 0; offset < count; ++offset) {
+        WorkerQueue& queue = *queues[(worker + offset) % count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) {
+            continue;
+        }
+        if (offset == 0) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        } else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        --queued;
+        return true;
+    }
+    return false;
+}
+
+// Bucle de cada hilo trabajador
+// Qué sucede: Ejecuta tareas mientras haya; si no hay, duerme hasta que llegue trabajo o se cierre el pool.
+void ThreadPool::workerLoop(int worker) {
+    while (true) {
+        Task task;
+        if (tryTake(worker, task)) {
+            task(worker);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this] { return stopping || queued.load() > 0; });
+        if (stopping && queued.load() == 0) {
+            return;
+        }
+    }
+}
+
+// Ejecutar un rango en paralelo
+// Qué sucede: Cada bloque descuenta un contador al terminar; el último despierta al hilo que espera.
+// Por qué sucede: El descuento y el aviso ocurren con `doneMutex` tomado. Si el contador se descontara fuera del
+//                 candado, quien espera podría ver 0, volver y destruir `doneMutex` y `done` mientras el último
+//                 bloque todavía los usa.
+void ThreadPool::parallelFor(int count, int grain, const RangeBody& body) {
+    if (count <= 0) {
+        return;
+    }
+    grain = std::max(1, grain);
+    int chunks = (count + grain - 1) / grain;
+
+    int remaining = chunks;  // Protegido por `doneMutex`
+    std::mutex doneMutex;
+    std::condition_variable done;
+
+    for (int chunk = 0; chunk < chunks; ++chunk) {
+        int begin = chunk * grain;
+        int end = std::min(count, begin + grain);
+        submit([&, begin, end](int worker) {
+            body(begin, end, worker);
+            std::lock_guard<std::mutex> lock(doneMutex);
+            if (--remaining == 0) {
+                done.notify_one();
+            }
+        });
+    }
+
+    std::unique_lock<std::mutex> lock(doneMutex);
+    done.wait(lock, [&] { return remaining == 0; });
+}
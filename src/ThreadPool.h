@@ -0,0 +1,65 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <memory>
+
+// Pool de hilos con robo de trabajo
+// Qué sucede: Cada hilo tiene su propia cola de tareas; toma trabajo del final de la suya y, si se queda sin trabajo,
+//             roba del principio de la cola de otro hilo.
+// Por qué sucede: Las consultas de rutas tienen costos muy distintos; robar trabajo reparte la carga sin un
+//                 planificador central.
+// Qué deberíamos esperar: Cada tarea recibe el índice del hilo que la ejecuta, para usar estado por hilo
+//                         (por ejemplo, un `SearchWorkspace`) sin bloqueos.
+class ThreadPool {
+public:
+    using Task = std::function<void(int worker)>;
+    using RangeBody = std::function<void(int begin, int end, int worker)>;
+
+    // Constructor
+    // Qué sucede: Lanza `threadCount` hilos; con 0 usa la cantidad de núcleos disponibles.
+    explicit ThreadPool(int threadCount = 0);
+
+    // Destructor
+    // Qué sucede: Termina las tareas pendientes y espera a que todos los hilos salgan.
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int getThreadCount() const { return static_cast<int>(threads.size()); }
+
+    // Encolar una tarea
+    // Qué sucede: La agrega a la cola de un hilo (en turno rotativo) y despierta a un hilo dormido.
+    void submit(Task task);
+
+    // Ejecutar un rango en paralelo y esperar
+    // Qué sucede: Divide `[0, count)` en bloques de `grain` elementos, los encola y bloquea hasta que terminan todos.
+    // Qué deberíamos esperar: No debe llamarse desde dentro de una tarea del mismo pool (esperaría a sí mismo).
+    void parallelFor(int count, int grain, const RangeBody& body);
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;  // Una cola por hilo
+    std::vector<std::thread> threads;  // Hilos trabajadores
+    std::mutex sleepMutex;  // Protege la espera de hilos sin trabajo
+    std::condition_variable wake;  // Despierta hilos cuando llega trabajo o al cerrar
+    std::atomic<int> queued;  // Tareas encoladas aún no tomadas
+    std::atomic<unsigned> nextQueue;  // Turno rotativo para `submit`
+    bool stopping;  // Indica que el pool se está cerrando
+
+    void workerLoop(int worker);
+    bool tryTake(int worker, Task& task);
+};
+
+#endif
@@ -0,0 +1,8 @@
+#include "UnionFind.h"
+
+void UnionFind::reset(int count) {
+    parent.resize(count);
+    for (int i = 0; i < count; ++i) {
+        parent[i] = i;
+    }
+}
@@ -0,0 +1,67 @@
+#ifndef UNION_FIND_H
+#define UNION_FIND_H
+
+#include <vector>
+#include <cstdint>
+
+// Conjuntos disjuntos (union-find) sobre índices de celda
+// Qué sucede: Cada celda apunta a un padre; `find` sigue los padres hasta la raíz acortando el camino a la mitad y
+//             `unite` cuelga la raíz de índice mayor de la de índice menor.
+// Por qué sucede: Etiquetar las zonas libres de un mapa con una sola pasada fila por fila, y unir zonas
+//                 calculadas por separado (por ejemplo, franjas de filas en distintos hilos).
+// Qué deberíamos esperar: La raíz de un conjunto es siempre su celda de menor índice, así que el resultado no depende
+//                         del orden de las uniones. Hilos distintos pueden trabajar a la vez sobre conjuntos que no
+//                         comparten celdas.
+class UnionFind {
+public:
+    explicit UnionFind(int count = 0) { reset(count); }
+
+    // Volver a `count` conjuntos de un elemento.
+    void reset(int count);
+
+    int find(int x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    }
+
+    // Unir los conjuntos de `a` y `b`; devuelve `false` si ya estaban unidos.
+    bool unite(int a, int b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) {
+            return false;
+        }
+        if (a < b) {
+            parent[b] = a;
+        } else {
+            parent[a] = b;
+        }
+        return true;
+    }
+
+    // Apuntar cada elemento de `[begin, end)` directo a su raíz
+    // Qué sucede: Como el padre de un elemento siempre tiene un índice menor o igual, recorriendo en orden el padre
+    //             ya apunta a la raíz y basta un salto por elemento.
+    // Qué deberíamos esperar: Después, `find` de esos elementos es un solo acceso.
+    void flatten(int begin, int end) {
+        for (int x = begin; x < end; ++x) {
+            parent[x] = parent[parent[x]];
+        }
+    }
+
+    // Padre directo de `x`; después de `flatten` es su raíz, sin recorrer ni modificar nada.
+    int parentOf(int x) const { return parent[x]; }
+
+    // Colgar `x`, que todavía es un conjunto de un elemento, de `parentIndex`, con `parentIndex <= x`; no busca raíces.
+    void attach(int x, int parentIndex) { parent[x] = parentIndex; }
+
+    int size() const { return static_cast<int>(parent.size()); }
+
+private:
+    std::vector<std::int32_t> parent;
+};
+
+#endif
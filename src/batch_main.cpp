@@ -0,0 +1,109 @@
+#include "Map.h"
+#include "MatchRunner.h"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+// Interpretar el nombre de una estrategia
+// Qué deberíamos esperar: `false` si el nombre no es `scripted` ni `random`.
+static bool parseStrategy(const std::string& name, PlayerStrategy& strategy) {
+    if (name == "scripted") {
+        strategy = PLAYER_SCRIPTED;
+    } else if (name == "random") {
+        strategy = PLAYER_RANDOM;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Corredor de partidas por lotes (`tankattack-batch`)
+// Qué sucede: Juega muchas partidas sin ventana en paralelo y escribe las estadísticas agregadas en CSV o JSON.
+// Opciones:
+//   --matches <n>             Cantidad de partidas (1000 por defecto)
+//   --threads <n>             Hilos (0 = todos los núcleos)
+//   --seed <n>                Semilla del lote; cada partida deriva la suya
+//   --player1 / --player2 <scripted|random>
+//   --map-size <n>            Tamaño del mapa
+//   --obstacles <porcentaje>  Porcentaje de obstáculos
+//   --map-strategy <noise|caves|rooms>  Estrategia del generador de mapas
+//   --terrain <porcentaje>    Barro y escombros del mapa generado (15 por defecto, 0 = todo llano)
+//   --map <archivo>           Mapa guardado con `tankattack-mapgen` (todas las partidas lo comparten sin copiarlo)
+//   --format <csv|json>       Formato de salida (csv por defecto)
+//   --output <archivo>        Archivo de salida (consola por defecto)
+int main(int argc, char* argv[]) {
+    GameConfig config;
+    config.verbose = false;
+    int matches = 1000;
+    int threads = 0;
+    PlayerStrategy player1 = PLAYER_SCRIPTED;
+    PlayerStrategy player2 = PLAYER_SCRIPTED;
+    std::string format = "csv";
+    std::string outputPath;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--matches" && hasValue) {
+            matches = std::atoi(argv[++i]);
+        } else if (arg == "--threads" && hasValue) {
+            threads = std::atoi(argv[++i]);
+        } else if (arg == "--seed" && hasValue) {
+            config.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--player1" && hasValue && parseStrategy(argv[i + 1], player1)) {
+            ++i;
+        } else if (arg == "--player2" && hasValue && parseStrategy(argv[i + 1], player2)) {
+            ++i;
+        } else if (arg == "--map-size" && hasValue) {
+            config.mapSize = std::atoi(argv[++i]);
+        } else if (arg == "--obstacles" && hasValue) {
+            config.obstaclePercentage = std::atoi(argv[++i]);
+        } else if (arg == "--map-strategy" && hasValue && MapGenerator::parseStrategy(argv[i + 1], config.mapStrategy)) {
+            ++i;
+        } else if (arg == "--terrain" && hasValue) {
+            config.terrainPercentage = std::atoi(argv[++i]);
+        } else if (arg == "--map" && hasValue) {
+            config.mapPath = argv[++i];
+        } else if (arg == "--format" && hasValue) {
+            format = argv[++i];
+        } else if (arg == "--output" && hasValue) {
+            outputPath = argv[++i];
+        } else {
+            std::cerr << "Opción desconocida o incompleta: " << arg << "\n";
+            return 1;
+        }
+    }
+    if (matches <= 0 || config.mapSize < GameState::MIN_MAP_SIZE || config.mapSize > Map::MAX_SIZE || (format != "csv" && format != "json")) {
+        std::cerr << "Parámetros inválidos\n";
+        return 1;
+    }
+    // Todas las partidas comparten la misma proyección del archivo de mapa
+    if (!config.mapPath.empty()) {
+        config.mapFile = MapFile::open(config.mapPath);
+        if (!config.mapFile || config.mapFile->getSize() < GameState::MIN_MAP_SIZE) {
+            std::cerr << "No se pudo leer el mapa " << config.mapPath << "\n";
+            return 1;
+        }
+    }
+
+    MatchRunner runner(threads);
+    std::vector<MatchResult> results;
+    BatchStats stats = runner.run(config, matches, player1, player2, results);
+
+    std::ofstream file;
+    if (!outputPath.empty()) {
+        file.open(outputPath);
+        if (!file) {
+            std::cerr << "No se pudo abrir " << outputPath << "\n";
+            return 1;
+        }
+    }
+    std::ostream& out = outputPath.empty() ? std::cout : file;
+    if (format == "json") {
+        writeStatsJson(out, stats);
+    } else {
+        writeStatsCsv(out, stats);
+    }
+    return 0;
+}
@@ -0,0 +1,649 @@
+#include "Map.h"
+#include "OccupancyGrid.h"
+#include "Tank.h"
+#include "BulletSystem.h"
+#include "Pathfinding.h"
+#include "SearchWorkspace.h"
+#include "PathCache.h"
+#include "FlowField.h"
+#include "HierarchicalPathfinder.h"
+#include "BatchPathfinder.h"
+#include "GridRaycast.h"
+#include "Rng.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Destino de los resultados de cada operación medida
+// Qué sucede: Cada operación suma algo de su resultado aquí.
+// Por qué sucede: Sin un efecto observable, el compilador con `-O2` podría eliminar la operación completa.
+static volatile std::size_t benchSink = 0;
+
+// Cantidad de comprobaciones de rutas que fallaron (el programa termina con código 1 si hay alguna)
+static int checkFailures = 0;
+
+// Comprobar que una ruta es transitable
+// Qué sucede: La ruta debe empezar en `start`, terminar en `end` y avanzar de a una celda libre en las 4 direcciones.
+// Por qué sucede: Los buscadores que no usa cada turno la partida (campo de flujo, HPA*, lotes) solo se ejercitan
+//                 aquí, así que antes de medirlos se compara su resultado con el de BFS o A*.
+static bool isWalkablePath(const Map& map, const std::vector<Cell>& path, const Cell& start, const Cell& end) {
+    if (path.empty() || path.front().x != start.x || path.front().y != start.y || path.back().x != end.x ||
+        path.back().y != end.y) {
+        return false;
+    }
+    for (std::size_t i = 0; i < path.size(); ++i) {
+        if (!map.isValidPosition(path[i].x, path[i].y)) {
+            return false;
+        }
+        if (i > 0 && std::abs(path[i].x - path[i - 1].x) + std::abs(path[i].y - path[i - 1].y) != 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Registrar una comprobación fallida en la consola de errores
+static void reportCheckFailure(const std::string& name, int size, int obstacles, const Cell& start, const Cell& end) {
+    ++checkFailures;
+    std::cerr << name << " size=" << size << " obstacles=" << obstacles << ": ruta incorrecta de (" << start.x << ","
+              << start.y << ") a (" << end.x << "," << end.y << ")\n";
+}
+
+// Parámetros de una medición
+struct BenchCase {
+    std::string name;
+    int mapSize;
+    int obstacles;  // Porcentaje de obstáculos (-1 si no aplica)
+    int tanks;  // Cantidad de tanques (-1 si no aplica)
+};
+
+// Resultado de una medición
+struct BenchResult {
+    BenchCase benchCase;
+    std::uint64_t iterations;  // Operaciones por repetición
+    double nsPerOp;  // Mediana de las repeticiones
+    double minNsPerOp;  // Mejor repetición
+};
+
+// Opciones de la corrida
+struct BenchOptions {
+    std::vector<int> mapSizes = {20, 64, 256};
+    std::vector<int> obstacles = {0, 10, 30};
+    std::vector<int> tanks = {8, 64};
+    std::string filter;  // Solo las mediciones cuyo nombre contiene este texto
+    double minSeconds = 0.05;  // Duración mínima de cada repetición
+    int repetitions = 5;
+    std::uint64_t seed = 1;
+};
+
+// Medir una operación
+// Qué sucede: Duplica la cantidad de iteraciones hasta que una repetición dura al menos `minSeconds`, y luego corre
+//             `repetitions` repeticiones con esa cantidad.
+// Por qué sucede: Las operaciones van de nanosegundos (línea de visión) a milisegundos (Dijkstra en 256x256); un
+//                 número fijo de iteraciones mediría ruido en unas y tardaría demasiado en otras.
+// Qué deberíamos esperar: La mediana es estable entre corridas; la mejor repetición indica el costo sin interferencias.
+template <typename Body>
+static BenchResult measure(const BenchCase& benchCase, const BenchOptions& options, Body body) {
+    using Clock = std::chrono::steady_clock;
+    auto run = [&](std::uint64_t iterations) {
+        Clock::time_point start = Clock::now();
+        body(iterations);
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    };
+
+    std::uint64_t iterations = 1;
+    while (run(iterations) < options.minSeconds && iterations < (1ull << 40)) {
+        iterations *= 2;
+    }
+
+    std::vector<double> samples;
+    for (int i = 0; i < options.repetitions; ++i) {
+        samples.push_back(run(iterations) * 1e9 / iterations);
+    }
+    std::sort(samples.begin(), samples.end());
+    return {benchCase, iterations, samples[samples.size() / 2], samples.front()};
+}
+
+// Escenario de prueba: mapa con obstáculos, tanques en celdas libres y pares de celdas para consultas
+// Qué deberíamos esperar: La misma semilla produce el mismo escenario, así que las corridas son comparables.
+struct Arena {
+    Map map;
+    OccupancyGrid occupancy;
+    std::vector<Tank> tanks;
+    std::vector<Cell> freeCells;  // Celdas sin obstáculos ni tanques
+    std::vector<Cell> queries;  // Pares consecutivos (origen, destino)
+
+    Arena(int size, int obstacles, int tankCount, Rng& rng) : map(size), occupancy(size) {
+        map.generateObstacles(obstacles, rng);
+
+        std::vector<Cell> candidates;
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                if (map.isValidPosition(x, y)) {
+                    candidates.push_back({x, y});
+                }
+            }
+        }
+        std::shuffle(candidates.begin(), candidates.end(), rng);
+
+        // Reservar antes de colocar: los tanques no deben moverse en memoria mientras se registran en la ocupación
+        int placed = std::min<int>(tankCount, candidates.size() / 2);
+        tanks.reserve(placed);
+        for (int i = 0; i < placed; ++i) {
+            tanks.emplace_back(static_cast<Tank::Color>(i % 4), candidates[i].x, candidates[i].y, i);
+            tanks.back().attachOccupancy(&occupancy);
+        }
+        freeCells.assign(candidates.begin() + placed, candidates.end());
+
+        for (int i = 0; i < 256 && freeCells.size() >= 2; ++i) {
+            queries.push_back(freeCells[rng.below(freeCells.size())]);
+            queries.push_back(freeCells[rng.below(freeCells.size())]);
+        }
+    }
+};
+
+// Dijkstra o A* con un heap binario como frontera (referencia para comparar con la cola por cubetas)
+// Qué sucede: La misma búsqueda que `dijkstra` o `aStar` (mismos costos de terreno y misma heurística), pero la
+//             frontera es un heap de `HeapEntry` como el que usa Jump Point Search.
+// Por qué sucede: La cola por cubetas reemplazó al heap en las búsquedas ponderadas; sin esta referencia no se podría
+//                 volver a medir la diferencia entre ambas colas.
+// Qué deberíamos esperar: Rutas del mismo costo que `dijkstra` y `aStar`; solo cambia el tiempo de la frontera.
+static bool heapCompare(const HeapEntry& a, const HeapEntry& b) {
+    if (a.f != b.f) return a.f > b.f;
+    return a.g < b.g;
+}
+
+static std::vector<Cell> heapSearch(const Map& map, int startX, int startY, int endX, int endY,
+                                    const OccupancyGrid& occupancy, SearchWorkspace& workspace, bool useHeuristic) {
+    static const int kOffsets[4][2] = {{0, 1}, {1, 0}, {0, -1}, {-1, 0}};
+    static const std::uint8_t kBits[4] = {Map::NEIGHBOR_DOWN, Map::NEIGHBOR_RIGHT, Map::NEIGHBOR_UP, Map::NEIGHBOR_LEFT};
+    if (!map.isReachable(startX, startY, endX, endY)) {
+        return {};
+    }
+    int size = map.getSize();
+    int minCost = useHeuristic ? map.getMinMoveCost() : 0;
+    auto estimate = [&](int x, int y) { return minCost * (std::abs(x - endX) + std::abs(y - endY)); };
+    workspace.beginSearch(size);
+    std::vector<HeapEntry>& open = workspace.heapBuffer();
+    open.clear();
+
+    int startIndex = map.cellIndex(startX, startY);
+    int endIndex = map.cellIndex(endX, endY);
+    workspace.visit(startIndex, -1, 0);
+    open.push_back({estimate(startX, startY), 0, startIndex});
+
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end(), heapCompare);
+        HeapEntry current = open.back();
+        open.pop_back();
+        if (current.g > workspace.getCost(current.index)) {
+            continue;  // Entrada obsoleta
+        }
+        if (current.index == endIndex) {
+            std::vector<Cell> path;
+            for (int at = endIndex; at != -1; at = workspace.getParent(at)) {
+                path.push_back({at % size, at / size});
+            }
+            std::reverse(path.begin(), path.end());
+            return path;
+        }
+
+        int x = current.index % size;
+        int y = current.index / size;
+        std::uint8_t mask = map.getNeighborMask(x, y);
+        for (int d = 0; d < 4; ++d) {
+            if (!(mask & kBits[d])) {
+                continue;
+            }
+            int newX = x + kOffsets[d][0];
+            int newY = y + kOffsets[d][1];
+            int newIndex = map.cellIndex(newX, newY);
+            if (!occupancy.isOccupied(newX, newY)) {
+                int newCost = current.g + map.getMoveCost(newIndex);
+                if (!workspace.isVisited(newIndex) || newCost < workspace.getCost(newIndex)) {
+                    workspace.visit(newIndex, current.index, newCost);
+                    open.push_back({newCost + estimate(newX, newY), newCost, newIndex});
+                    std::push_heap(open.begin(), open.end(), heapCompare);
+                }
+            }
+        }
+    }
+    return {};
+}
+
+// Leer una lista de enteros separados por comas
+static bool parseList(const std::string& text, std::vector<int>& values) {
+    values.clear();
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        values.push_back(std::atoi(item.c_str()));
+    }
+    return !values.empty();
+}
+
+static void writeCsv(std::ostream& out, const std::vector<BenchResult>& results) {
+    out << "benchmark,map_size,obstacles,tanks,iterations,ns_per_op,min_ns_per_op,ops_per_second\n";
+    for (const BenchResult& result : results) {
+        const BenchCase& c = result.benchCase;
+        out << c.name << "," << c.mapSize << "," << c.obstacles << "," << c.tanks << "," << result.iterations << ","
+            << result.nsPerOp << "," << result.minNsPerOp << "," << 1e9 / result.nsPerOp << "\n";
+    }
+}
+
+static void writeJson(std::ostream& out, const std::vector<BenchResult>& results) {
+    out << "[\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& result = results[i];
+        const BenchCase& c = result.benchCase;
+        out << "  {\"benchmark\": \"" << c.name << "\", \"map_size\": " << c.mapSize
+            << ", \"obstacles\": " << c.obstacles << ", \"tanks\": " << c.tanks
+            << ", \"iterations\": " << result.iterations << ", \"ns_per_op\": " << result.nsPerOp
+            << ", \"min_ns_per_op\": " << result.minNsPerOp << ", \"ops_per_second\": " << 1e9 / result.nsPerOp << "}"
+            << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "]\n";
+}
+
+// Correr todas las mediciones
+// Qué sucede: Recorre tamaños de mapa, densidades de obstáculos y cantidades de tanques; cada medición solo se
+//             repite para los parámetros de los que depende (construir un `Map` no depende de los tanques).
+static std::vector<BenchResult> runAll(const BenchOptions& options) {
+    std::vector<BenchResult> results;
+    auto enabled = [&](const std::string& name) {
+        return options.filter.empty() || name.find(options.filter) != std::string::npos;
+    };
+    auto report = [&](const BenchResult& result) {
+        results.push_back(result);
+        const BenchCase& c = result.benchCase;
+        std::cerr << c.name << " size=" << c.mapSize << " obstacles=" << c.obstacles << " tanks=" << c.tanks
+                  << ": " << result.nsPerOp << " ns/op\n";
+    };
+
+    for (int size : options.mapSizes) {
+        // Construcción del mapa (sin obstáculos)
+        if (enabled("map_construct")) {
+            report(measure({"map_construct", size, -1, -1}, options, [&](std::uint64_t iterations) {
+                for (std::uint64_t i = 0; i < iterations; ++i) {
+                    Map map(size);
+                    benchSink = benchSink + map.getNeighborMask(0, 0);
+                }
+            }));
+        }
+
+        for (int obstacles : options.obstacles) {
+            // Generación de obstáculos sobre un mapa ya construido
+            if (enabled("generate_obstacles")) {
+                Map map(size);
+                Rng rng(options.seed);
+                report(measure({"generate_obstacles", size, obstacles, -1}, options, [&](std::uint64_t iterations) {
+                    for (std::uint64_t i = 0; i < iterations; ++i) {
+                        map.generateObstacles(obstacles, rng);
+                        benchSink = benchSink + map.getVersion();
+                    }
+                }));
+            }
+
+            // Línea de visión entre pares de celdas libres
+            if (enabled("line_of_sight")) {
+                Rng rng(options.seed);
+                Arena arena(size, obstacles, 0, rng);
+                if (!arena.queries.empty()) {
+                    const std::vector<Cell>& q = arena.queries;
+                    report(measure({"line_of_sight", size, obstacles, -1}, options, [&](std::uint64_t iterations) {
+                        for (std::uint64_t i = 0; i < iterations; ++i) {
+                            std::size_t at = (i * 2) % q.size();
+                            benchSink = benchSink + isLineOfSightClear(q[at].x, q[at].y, q[at + 1].x, q[at + 1].y,
+                                                                       arena.map);
+                        }
+                    }));
+                }
+            }
+
+            // Buscadores que solo consideran el terreno: campo de flujo y HPA*
+            bool flowFieldEnabled = enabled("flow_field_compute") || enabled("flow_field_path");
+            bool hpaEnabled = enabled("hpa_build") || enabled("hpa_path");
+            if (flowFieldEnabled || hpaEnabled) {
+                Rng rng(options.seed);
+                Arena arena(size, obstacles, 0, rng);
+                const std::vector<Cell>& q = arena.queries;
+                if (!q.empty()) {
+                    // Inundar todo el mapa hacia un objetivo, y seguir el campo desde cada origen hacia ese objetivo
+                    // Cada ruta del campo debe ser transitable y tener tantas celdas como la de BFS
+                    FlowField field;
+                    for (std::size_t at = 0; at < q.size() && flowFieldEnabled; at += 2) {
+                        field.compute(arena.map, q[at + 1].x, q[at + 1].y);
+                        std::vector<Cell> expected = bfs(arena.map, q[at].x, q[at].y, q[at + 1].x, q[at + 1].y,
+                                                         arena.occupancy);
+                        std::vector<Cell> path = field.extractPath(q[at].x, q[at].y);
+                        bool same = expected.empty() ? path.empty() : path.size() == expected.size() &&
+                                                                      isWalkablePath(arena.map, path, q[at], q[at + 1]);
+                        if (!same) {
+                            reportCheckFailure("flow_field", size, obstacles, q[at], q[at + 1]);
+                        }
+                    }
+                    if (enabled("flow_field_compute")) {
+                        report(measure({"flow_field_compute", size, obstacles, -1}, options, [&](std::uint64_t iterations) {
+                            for (std::uint64_t i = 0; i < iterations; ++i) {
+                                const Cell& target = q[(i * 2 + 1) % q.size()];
+                                field.compute(arena.map, target.x, target.y);
+                                benchSink = benchSink + field.getDistance(0, 0);
+                            }
+                        }));
+                    }
+                    if (enabled("flow_field_path")) {
+                        field.compute(arena.map, q[1].x, q[1].y);
+                        report(measure({"flow_field_path", size, obstacles, -1}, options, [&](std::uint64_t iterations) {
+                            for (std::uint64_t i = 0; i < iterations; ++i) {
+                                const Cell& start = q[(i * 2) % q.size()];
+                                benchSink = benchSink + field.extractPath(start.x, start.y).size();
+                            }
+                        }));
+                    }
+
+                    // Construir el grafo abstracto completo, y consultas sobre un grafo ya construido
+                    // Las rutas de HPA* deben ser transitables y no más cortas que las de BFS. Después de que `update`
+                    // incorpore obstáculos desde el registro de cambios del mapa, deben coincidir con las de un grafo
+                    // construido desde cero
+                    HierarchicalPathfinder hpa;
+                    auto checkHpa = [&](HierarchicalPathfinder* rebuilt) {
+                        if (rebuilt) {
+                            rebuilt->build(arena.map);
+                        }
+                        for (std::size_t at = 0; at < q.size(); at += 2) {
+                            const Cell& start = q[at];
+                            const Cell& end = q[at + 1];
+                            if (!arena.map.isValidPosition(start.x, start.y) || !arena.map.isValidPosition(end.x, end.y)) {
+                                continue;
+                            }
+                            std::vector<Cell> expected = bfs(arena.map, start.x, start.y, end.x, end.y, arena.occupancy);
+                            std::vector<Cell> path = hpa.findPath(arena.map, start.x, start.y, end.x, end.y);
+                            bool valid = expected.empty() ? path.empty() : path.size() >= expected.size() &&
+                                                                        isWalkablePath(arena.map, path, start, end);
+                            if (valid && rebuilt) {
+                                std::vector<Cell> reference = rebuilt->findPath(arena.map, start.x, start.y, end.x, end.y);
+                                valid = reference.size() == path.size() &&
+                                        std::equal(path.begin(), path.end(), reference.begin(), [](const Cell& a, const Cell& b) {
+                                            return a.x == b.x && a.y == b.y;
+                                        });
+                            }
+                            if (!valid) {
+                                reportCheckFailure("hpa", size, obstacles, start, end);
+                            }
+                        }
+                    };
+                    if (hpaEnabled) {
+                        HierarchicalPathfinder rebuilt;
+                        hpa.build(arena.map);
+                        checkHpa(nullptr);
+                        std::vector<Cell> walls(arena.freeCells.begin(),
+                                                arena.freeCells.begin() + std::min<std::size_t>(arena.freeCells.size() / 8, 512));
+                        for (const Cell& cell : walls) {
+                            arena.map.setObstacle(cell.x, cell.y, true);
+                        }
+                        hpa.update(arena.map);
+                        checkHpa(&rebuilt);
+                        for (const Cell& cell : walls) {
+                            arena.map.setObstacle(cell.x, cell.y, false);
+                        }
+                        hpa.update(arena.map);
+                        checkHpa(&rebuilt);
+                    }
+
+                    if (enabled("hpa_build")) {
+                        report(measure({"hpa_build", size, obstacles, -1}, options, [&](std::uint64_t iterations) {
+                            for (std::uint64_t i = 0; i < iterations; ++i) {
+                                hpa.build(arena.map);
+                                benchSink = benchSink + hpa.getNodeCount();
+                            }
+                        }));
+                    }
+                    if (enabled("hpa_path")) {
+                        hpa.build(arena.map);
+                        report(measure({"hpa_path", size, obstacles, -1}, options, [&](std::uint64_t iterations) {
+                            for (std::uint64_t i = 0; i < iterations; ++i) {
+                                std::size_t at = (i * 2) % q.size();
+                                benchSink = benchSink + hpa.findPath(arena.map, q[at].x, q[at].y, q[at + 1].x,
+                                                                     q[at + 1].y).size();
+                            }
+                        }));
+                    }
+                }
+            }
+
+            for (int tankCount : options.tanks) {
+                Rng rng(options.seed);
+                Arena arena(size, obstacles, tankCount, rng);
+                const std::vector<Cell>& q = arena.queries;
+                if (q.empty() || arena.tanks.empty()) {
+                    continue;
+                }
+
+                if (enabled("bfs")) {
+                    report(measure({"bfs", size, obstacles, tankCount}, options, [&](std::uint64_t iterations) {
+                        for (std::uint64_t i = 0; i < iterations; ++i) {
+                            std::size_t at = (i * 2) % q.size();
+                            benchSink = benchSink + bfs(arena.map, q[at].x, q[at].y, q[at + 1].x, q[at + 1].y,
+                                                        arena.occupancy).size();
+                        }
+                    }));
+                }
+
+                if (enabled("dijkstra")) {
+                    report(measure({"dijkstra", size, obstacles, tankCount}, options, [&](std::uint64_t iterations) {
+                        for (std::uint64_t i = 0; i < iterations; ++i) {
+                            std::size_t at = (i * 2) % q.size();
+                            benchSink = benchSink + dijkstra(arena.map, q[at].x, q[at].y, q[at + 1].x, q[at + 1].y,
+                                                             arena.occupancy).size();
+                        }
+                    }));
+                }
+
+                // A* con la cola por cubetas, y Dijkstra y A* con la referencia de heap, sobre las mismas consultas
+                SearchWorkspace workspace(size);
+                struct WeightedSearch {
+                    const char* name;
+                    PathAlgorithm algorithm;
+                    bool heap;
+                };
+                const WeightedSearch weightedSearches[] = {
+                    {"astar", PATH_ASTAR, false},
+                    {"dijkstra_heap", PATH_DIJKSTRA, true},
+                    {"astar_heap", PATH_ASTAR, true}
+                };
+                for (const WeightedSearch& search : weightedSearches) {
+                    if (!enabled(search.name)) {
+                        continue;
+                    }
+                    report(measure({search.name, size, obstacles, tankCount}, options, [&](std::uint64_t iterations) {
+                        for (std::uint64_t i = 0; i < iterations; ++i) {
+                            std::size_t at = (i * 2) % q.size();
+                            std::vector<Cell> path = search.heap
+                                ? heapSearch(arena.map, q[at].x, q[at].y, q[at + 1].x, q[at + 1].y, arena.occupancy,
+                                             workspace, search.algorithm == PATH_ASTAR)
+                                : findPath(search.algorithm, arena.map, q[at].x, q[at].y, q[at + 1].x, q[at + 1].y,
+                                           arena.occupancy, workspace);
+                            benchSink = benchSink + path.size();
+                        }
+                    }));
+                }
+
+                if (enabled("jps")) {
+                    report(measure({"jps", size, obstacles, tankCount}, options, [&](std::uint64_t iterations) {
+                        for (std::uint64_t i = 0; i < iterations; ++i) {
+                            std::size_t at = (i * 2) % q.size();
+                            benchSink = benchSink + jumpPointSearch(arena.map, q[at].x, q[at].y, q[at + 1].x,
+                                                                    q[at + 1].y, arena.occupancy, workspace).size();
+                        }
+                    }));
+                }
+
+                // A* detrás de la caché de rutas; las consultas caben en la caché, así que casi todas son aciertos
+                if (enabled("path_cache")) {
+                    PathCache cache(q.size());
+                    report(measure({"path_cache", size, obstacles, tankCount}, options, [&](std::uint64_t iterations) {
+                        for (std::uint64_t i = 0; i < iterations; ++i) {
+                            std::size_t at = (i * 2) % q.size();
+                            benchSink = benchSink + cache.findPath(PATH_ASTAR, arena.map, arena.occupancy, q[at].x,
+                                                                   q[at].y, q[at + 1].x, q[at + 1].y).size();
+                        }
+                    }));
+                }
+
+                // Un lote con todas las consultas, resuelto con A* en todos los núcleos (una operación = un lote)
+                if (enabled("batch_pathfinder")) {
+                    BatchPathfinder batch;
+                    std::vector<PathRequest> requests;
+                    for (std::size_t at = 0; at + 1 < q.size(); at += 2) {
+                        requests.push_back({static_cast<int>(at / 2), q[at].x, q[at].y, q[at + 1].x, q[at + 1].y,
+                                            PATH_ASTAR});
+                    }
+
+                    // Con los cuatro algoritmos mezclados, cada ruta del lote debe ser la misma que la de una búsqueda
+                    // en serie
+                    std::vector<PathRequest> mixed = requests;
+                    for (std::size_t r = 0; r < mixed.size(); ++r) {
+                        mixed[r].algorithm = static_cast<PathAlgorithm>(r % 4);
+                    }
+                    std::vector<std::vector<Cell>> solved = batch.solve(arena.map, arena.occupancy, mixed);
+                    for (std::size_t r = 0; r < mixed.size(); ++r) {
+                        const PathRequest& request = mixed[r];
+                        std::vector<Cell> expected = findPath(request.algorithm, arena.map, request.startX, request.startY,
+                                                              request.goalX, request.goalY, arena.occupancy, workspace);
+                        bool same = r < solved.size() && solved[r].size() == expected.size() &&
+                                    std::equal(expected.begin(), expected.end(), solved[r].begin(),
+                                               [](const Cell& a, const Cell& b) { return a.x == b.x && a.y == b.y; });
+                        if (!same) {
+                            reportCheckFailure("batch_pathfinder", size, obstacles, {request.startX, request.startY},
+                                               {request.goalX, request.goalY});
+                        }
+                    }
+                    report(measure({"batch_pathfinder", size, obstacles, tankCount}, options, [&](std::uint64_t iterations) {
+                        for (std::uint64_t i = 0; i < iterations; ++i) {
+                            benchSink = benchSink + batch.solve(arena.map, arena.occupancy, requests).size();
+                        }
+                    }));
+                }
+
+                if (enabled("move_randomly")) {
+                    report(measure({"move_randomly", size, obstacles, tankCount}, options, [&](std::uint64_t iterations) {
+                        for (std::uint64_t i = 0; i < iterations; ++i) {
+                            const Tank& tank = arena.tanks[i % arena.tanks.size()];
+                            benchSink = benchSink + moveRandomly(tank.getX(), tank.getY(), arena.map, arena.occupancy,
+                                                                 rng).size();
+                        }
+                    }));
+                }
+
+                // Un tick del sistema de balas con 64 balas activas; las que se destruyen se vuelven a disparar
+                // desde un tanque hacia una celda libre
+                if (enabled("bullet_system_update")) {
+                    std::size_t shots = 0;
+                    auto refill = [&](BulletSystem& bullets) {
+                        while (bullets.getActiveCount() < 64) {
+                            const Tank& shooter = arena.tanks[shots % arena.tanks.size()];
+                            const Cell& target = q[(shots * 2) % q.size()];
+                            int targetX = target.x == shooter.getX() && target.y == shooter.getY() ? target.x + 1 : target.x;
+                            bullets.spawn(shooter.getX(), shooter.getY(), targetX, target.y, shooter.getId());
+                            ++shots;
+                        }
+                    };
+                    BulletSystem bullets(64);
+                    refill(bullets);
+                    report(measure({"bullet_system_update", size, obstacles, tankCount}, options, [&](std::uint64_t iterations) {
+                        for (std::uint64_t i = 0; i < iterations; ++i) {
+                            bullets.update(arena.map, arena.occupancy, arena.tanks);
+                            refill(bullets);
+                        }
+                        benchSink = benchSink + shots;
+                    }));
+                }
+            }
+        }
+    }
+    return results;
+}
+
+// Microbenchmarks (`tankattack-bench`)
+// Qué sucede: Mide BFS, Dijkstra, A*, Jump Point Search, la caché de rutas, el campo de flujo, HPA*, las búsquedas por
+//             lotes, movimiento aleatorio, construcción del mapa, generación de obstáculos, línea de visión y
+//             `BulletSystem::update`, y escribe los resultados en CSV o JSON. El progreso va a la consola de errores.
+//             `dijkstra` y `astar` usan la cola por cubetas; `dijkstra_heap` y `astar_heap` repiten las mismas consultas
+//             con un heap binario de referencia.
+//             Antes de medir un buscador que la partida no usa cada turno, se comparan sus rutas con las de BFS o A*
+//             sobre las mismas consultas; si alguna no coincide, se informa y el programa termina con código 1.
+// Opciones:
+//   --sizes <a,b,...>       Tamaños de mapa (20,64,256 por defecto)
+//   --obstacles <a,b,...>   Porcentajes de obstáculos (0,10,30 por defecto)
+//   --tanks <a,b,...>       Cantidades de tanques (8,64 por defecto)
+//   --filter <texto>        Solo las mediciones cuyo nombre contiene el texto
+//   --min-time <segundos>   Duración mínima de cada repetición (0.05 por defecto)
+//   --repetitions <n>       Repeticiones por medición (5 por defecto)
+//   --seed <n>              Semilla de los escenarios
+//   --format <csv|json>     Formato de salida (csv por defecto)
+//   --output <archivo>      Archivo de salida (consola por defecto)
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    std::string format = "csv";
+    std::string outputPath;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--sizes" && hasValue && parseList(argv[i + 1], options.mapSizes)) {
+            ++i;
+        } else if (arg == "--obstacles" && hasValue && parseList(argv[i + 1], options.obstacles)) {
+            ++i;
+        } else if (arg == "--tanks" && hasValue && parseList(argv[i + 1], options.tanks)) {
+            ++i;
+        } else if (arg == "--filter" && hasValue) {
+            options.filter = argv[++i];
+        } else if (arg == "--min-time" && hasValue) {
+            options.minSeconds = std::atof(argv[++i]);
+        } else if (arg == "--repetitions" && hasValue) {
+            options.repetitions = std::atoi(argv[++i]);
+        } else if (arg == "--seed" && hasValue) {
+            options.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--format" && hasValue) {
+            format = argv[++i];
+        } else if (arg == "--output" && hasValue) {
+            outputPath = argv[++i];
+        } else {
+            std::cerr << "Opción desconocida o incompleta: " << arg << "\n";
+            return 1;
+        }
+    }
+    bool validSizes = std::all_of(options.mapSizes.begin(), options.mapSizes.end(), [](int size) { return size >= 2; });
+    if (!validSizes || options.repetitions <= 0 || (format != "csv" && format != "json")) {
+        std::cerr << "Parámetros inválidos\n";
+        return 1;
+    }
+
+    std::vector<BenchResult> results = runAll(options);
+
+    std::ofstream file;
+    if (!outputPath.empty()) {
+        file.open(outputPath);
+        if (!file) {
+            std::cerr << "No se pudo abrir " << outputPath << "\n";
+            return 1;
+        }
+    }
+    std::ostream& out = outputPath.empty() ? std::cout : file;
+    if (format == "json") {
+        writeJson(out, results);
+    } else {
+        writeCsv(out, results);
+    }
+    if (checkFailures > 0) {
+        std::cerr << checkFailures << " comprobaciones de rutas fallaron\n";
+        return 1;
+    }
+    return 0;
+}
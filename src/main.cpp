@@ -1,409 +1,478 @@
+#ifndef TANKATTACK_HEADLESS
 #include <SFML/Graphics.hpp>
-#include "Map.h"
-#include "Tank.h"
-#include "Pathfinding.h"
-#include "Bullet.h"
+#include "Renderer.h"
+#include "FrameStats.h"
+#endif
+#include "GameState.h"
+#include "AutoPlayer.h"
+#include "FixedTimestep.h"
+#include "Profiler.h"
+#include "InputLog.h"
 #include <vector>
 #include <cstdlib>
 #include <ctime>
 #include <iostream>
-#include <queue>
-#include <algorithm>
-#include <climits>
-
-// Función para generar un número aleatorio entre dos valores
-// Qué sucede: Genera un número aleatorio entre `min` y `max`.
-// Por qué sucede: Se utiliza para colocar tanques o generar otros elementos aleatoriamente en el mapa.
-// Qué deberíamos esperar: Un número aleatorio dentro del rango especificado.
-int getRandomPosition(int min, int max) {
-    return std::rand() % (max - min + 1) + min;
+#include <string>
+#include <chrono>
+#include <fstream>
+
+// Mostrar el resultado de la partida
+// Qué sucede: Declara al ganador según la cantidad de tanques vivos.
+void printResult(const GameState& state) {
+    int player1TanksAlive = state.countAliveTanks(1);
+    int player2TanksAlive = state.countAliveTanks(2);
+    if (state.getWinner() == 1) {
+        std::cout << "Jugador 1 gana con " << player1TanksAlive << " tanques vivos.\n";
+    } else if (state.getWinner() == 2) {
+        std::cout << "Jugador 2 gana con " << player2TanksAlive << " tanques vivos.\n";
+    } else {
+        std::cout << "Empate, ambos jugadores tienen la misma cantidad de tanques vivos.\n";
+    }
 }
 
-// Función para verificar si una celda está ocupada por un tanque
-// Qué sucede: Revisa si un tanque está en la posición dada.
-// Por qué sucede: Es importante para evitar colisiones y asegurarse de que los tanques no ocupen la misma posición.
-// Qué deberíamos esperar: `true` si la posición está ocupada por un tanque, `false` si está libre.
-bool isPositionOccupied(int x, int y, const std::vector<Tank>& tanks) {
-    for (const Tank& tank : tanks) {
-        if (tank.getX() == x && tank.getY() == y) {
-            return true;
-        }
+// Avanzar un tick anotando las entradas
+// Qué sucede: Si hay registro, guarda las entradas con el tick en que se aplican y, al terminar la partida, el resultado.
+void stepAndRecord(GameState& state, const std::vector<GameInput>& inputs, InputLog* recording) {
+    if (recording != nullptr && !inputs.empty()) {
+        recording->record(state.getTick(), inputs);
+    }
+    state.step(inputs);
+    if (recording != nullptr && state.isGameOver()) {
+        recording->finish(state.getTick(), state.getWinner());
     }
-    return false;
 }
 
-// Función para contar los tanques vivos de un jugador según su color
-// Qué sucede: Cuenta cuántos tanques de un color específico están aún activos.
-// Por qué sucede: Para determinar si un jugador ha perdido todos sus tanques.
-// Qué deberíamos esperar: El número de tanques vivos de un jugador.
-int countAliveTanks(const std::vector<Tank>& tanks, const std::vector<Tank::Color>& playerColors) {
-    int count = 0;
-    for (const Tank& tank : tanks) {
-        if (!tank.isDestroyed() && std::find(playerColors.begin(), playerColors.end(), tank.getColor()) != playerColors.end()) {
-            count++;
+// Comparar el final de una repetición con el registro
+// Qué deberíamos esperar: Un aviso si el tick final o el ganador no coinciden con los guardados.
+int checkReplay(const GameState& state, const InputLog& log) {
+    if (!log.hasResult()) {
+        std::cout << "El registro no tiene resultado (la partida original no terminó)\n";
+        return 0;
+    }
+    if (state.getTick() != log.getFinalTick() || state.getWinner() != log.getWinner()) {
+        std::cout << "La repetición NO coincide: registro tick " << log.getFinalTick() << " ganador " << log.getWinner()
+                  << ", repetición tick " << state.getTick() << " ganador " << state.getWinner() << "\n";
+        return 1;
+    }
+    std::cout << "La repetición coincide con el registro\n";
+    return 0;
+}
+
+// Reproducir un registro a máxima velocidad
+// Qué sucede: Aplica las entradas del registro en sus ticks sin dibujar ni esperar.
+// Por qué sucede: Para llegar en milisegundos al momento en que una partida se comportó mal.
+int runReplayFast(const GameConfig& config, InputLog& log) {
+    GameState state(config);
+    std::vector<GameInput> inputs;
+
+    auto start = std::chrono::steady_clock::now();
+    while (!state.isGameOver()) {
+        inputs.clear();
+        log.inputsAt(state.getTick(), inputs);
+        state.step(inputs);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (state.isGameOver()) {
+        printResult(state);
+    }
+    std::cout << "Ticks: " << state.getTick() << ", entradas: " << log.getInputCount() << ", tiempo real: "
+              << seconds << " s\n";
+    return checkReplay(state, log);
+}
+
+// Correr una partida sin ventana
+// Qué sucede: Dos `AutoPlayer` juegan una partida completa llamando a `step` tan rápido como se pueda.
+// Por qué sucede: Permite evaluar IAs sin pantalla ni SFML.
+// Qué deberíamos esperar: El resultado y la cantidad de ticks por segundo simulados.
+int runHeadless(const GameConfig& config, InputLog* recording) {
+    GameState state(config);
+    AutoPlayer players[2] = {AutoPlayer(1, PLAYER_SCRIPTED, Rng::deriveSeed(config.seed, 1)),
+                             AutoPlayer(2, PLAYER_SCRIPTED, Rng::deriveSeed(config.seed, 2))};
+    std::vector<GameInput> inputs;
+
+    auto start = std::chrono::steady_clock::now();
+    while (!state.isGameOver()) {
+        inputs.clear();
+        {
+            PROFILE_SCOPE("think");
+            players[0].think(state, inputs);
+            players[1].think(state, inputs);
         }
+        stepAndRecord(state, inputs, recording);
     }
-    return count;
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printResult(state);
+    std::cout << "Ticks: " << state.getTick() << ", tiempo real: " << seconds << " s, "
+              << (seconds > 0 ? state.getTick() / seconds : 0.0) << " ticks/s\n";
+    return 0;
 }
 
-// Enumeración de los power-ups
-// Qué sucede: Se definen los diferentes tipos de power-ups disponibles en el juego.
-// Por qué sucede: Para permitir efectos especiales que los jugadores puedan utilizar durante el juego.
-enum PowerUp {
-    NONE,
-    DOUBLE_TURN,
-    MOVE_PRECISION,
-    ATTACK_PRECISION,
-    ATTACK_POWER
+#ifndef TANKATTACK_HEADLESS
+// Opciones del modo con ventana
+struct WindowOptions {
+    int maxTicksPerFrame = 8;  // Ticks máximos que se recuperan en un frame
+    bool renderEnabled = true;  // Dibujar (la simulación no depende de esto)
+    unsigned frameLimit = 60;  // Frames por segundo máximos (0 = sin límite)
+    bool vsync = false;  // Sincronización vertical (reemplaza el límite de frames)
+    bool idleWait = true;  // Esperar eventos cuando no hay nada animándose
+    bool frameStats = false;  // Mostrar el resumen de frames y CPU al salir
+    bool profileOverlay = false;  // Mostrar el perfilador sobre el juego al empezar (F3 lo alterna)
 };
 
-// Control del número de turnos adicionales por power-up de doble turno
-int turnControl[2] = {0, 0};  // `turnControl[0]` para jugador 1, `turnControl[1]` para jugador 2
+// Traducir un evento de SFML a entradas de `GameState`
+// Qué sucede: Clic izquierdo -> `INPUT_CLICK` en la celda; teclas M, D y P -> mover, disparar y power-up. F3 muestra u
+//             oculta el perfilador (no es una entrada del juego).
+void handleEvent(const sf::Event& event, sf::RenderWindow& window, const Renderer& renderer,
+                 std::vector<GameInput>& pendingInputs, bool& profileOverlay) {
+    // Cerrar la ventana si se presiona el botón de cierre
+    if (event.type == sf::Event::Closed)
+        window.close();
+
+    // Clic izquierdo: seleccionar tanque, elegir destino o elegir objetivo del disparo
+    if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
+        pendingInputs.push_back({INPUT_CLICK, renderer.toCell(event.mouseButton.x), renderer.toCell(event.mouseButton.y)});
+    }
 
-int main() {
-    // Inicializar la semilla de números aleatorios
-    std::srand(std::time(nullptr));
+    // Teclas M (mover), D (disparar) y P (power-up)
+    if (event.type == sf::Event::KeyPressed) {
+        if (event.key.code == sf::Keyboard::M) {
+            pendingInputs.push_back({INPUT_MOVE});
+        } else if (event.key.code == sf::Keyboard::D) {
+            pendingInputs.push_back({INPUT_SHOOT});
+        } else if (event.key.code == sf::Keyboard::P) {
+            pendingInputs.push_back({INPUT_POWER_UP});
+        } else if (event.key.code == sf::Keyboard::F3) {
+            profileOverlay = !profileOverlay;
+        }
+    }
+}
+
+// Esperar un evento con tiempo máximo
+// Qué sucede: Revisa la cola de eventos y duerme en intervalos cortos hasta que llega uno o se cumple `maxWait`.
+// Por qué sucede: `sf::Window::waitEvent` de SFML 2 no acepta un tiempo máximo, y la partida no puede quedarse
+//                 bloqueada: el turno y el reloj siguen corriendo aunque nadie toque nada.
+// Qué deberíamos esperar: `true` y el evento en `event` si llegó uno; el proceso casi no usa CPU mientras espera.
+bool waitEventFor(sf::RenderWindow& window, sf::Event& event, sf::Time maxWait) {
+    const sf::Time slice = sf::milliseconds(5);  // Latencia máxima agregada a una entrada
+    sf::Clock waited;
+    while (!window.pollEvent(event)) {
+        sf::Time remaining = maxWait - waited.getElapsedTime();
+        if (remaining <= sf::Time::Zero) {
+            return false;
+        }
+        sf::sleep(remaining < slice ? remaining : slice);
+    }
+    return true;
+}
 
-    // Dimensiones del mapa
-    const int mapSize = 20;  // Tamaño del mapa (20x20)
+// Correr una partida con ventana
+// Qué sucede: Traduce los eventos de SFML a entradas de `GameState`, simula con paso fijo y dibuja con `Renderer`.
+//             Con `replay`, las entradas salen del registro y los clics y teclas del juego se ignoran.
+// Por qué sucede: La ventana es la interfaz principal donde se desarrolla el juego.
+int runWindowed(const GameConfig& config, const WindowOptions& options, InputLog* recording, InputLog* replay) {
     const int cellSize = 30; // Tamaño de cada celda (en píxeles)
 
+    // La partida se crea primero: con un archivo de mapa, el tamaño de la ventana depende del mapa cargado
+    GameState state(config);
+    const int mapSize = state.getConfig().mapSize;
+
     // Crear ventana del juego
     // Qué sucede: Se crea una ventana para mostrar el juego.
-    // Por qué sucede: La ventana es la interfaz principal donde se desarrolla el juego.
     // Qué deberíamos esperar: Una ventana gráfica que representa el campo de juego.
     sf::RenderWindow window(sf::VideoMode(mapSize * cellSize, mapSize * cellSize + 50), "Tank Attack!");
+    Renderer renderer(window, mapSize, cellSize);
+
+    // Ritmo de frames
+    // Qué sucede: Con vsync, `display` espera al refresco de la pantalla; si no, SFML duerme lo necesario para no
+    //             pasar de `frameLimit` frames por segundo.
+    // Por qué sucede: Sin límite el bucle dibujaba miles de frames por segundo y ocupaba un núcleo entero.
+    if (options.vsync) {
+        window.setVerticalSyncEnabled(true);
+    } else {
+        window.setFramerateLimit(options.frameLimit);
+    }
 
     // Cargar la fuente para los textos del juego
-    sf::Font font;
-    if (!font.loadFromFile("fonts/arial.ttf")) {
+    if (!renderer.loadFont("fonts/arial.ttf")) {
         std::cerr << "Error cargando la fuente\n";
         return -1; // Termina el programa si no se encuentra la fuente
     }
 
-    // Crear el texto para el contador de turnos y el temporizador global
-    // Qué sucede: Se inicializan los elementos de texto para mostrar el estado del juego.
-    // Por qué sucede: Se proporciona retroalimentación visual a los jugadores (turnos y tiempo).
-    sf::Text turnText;
-    turnText.setFont(font);
-    turnText.setCharacterSize(24);
-    turnText.setFillColor(sf::Color::Black);
-    turnText.setPosition(10, mapSize * cellSize);
-
-    sf::Text globalTimerText;
-    globalTimerText.setFont(font);
-    globalTimerText.setCharacterSize(24);
-    globalTimerText.setFillColor(sf::Color::Black);
-    globalTimerText.setPosition(window.getSize().x - 180, mapSize * cellSize);
-
-    sf::Text powerUpText;
-    powerUpText.setFont(font);
-    powerUpText.setCharacterSize(24);
-    powerUpText.setFillColor(sf::Color::Black);
-    powerUpText.setPosition(10, mapSize * cellSize + 25);
-
-    // Crear el mapa y generar obstáculos
-    // Qué sucede: Se inicializa el mapa y se colocan obstáculos en celdas aleatorias.
-    // Por qué sucede: Los obstáculos añaden dificultad y estrategia al movimiento de los tanques.
-    Map gameMap(mapSize);
-    gameMap.generateObstacles(10);  // Generar con un 10% de obstáculos
-
-    // Crear los tanques del jugador 1 y del jugador 2
-    // Qué sucede: Se añaden los tanques de cada jugador a la lista de tanques.
-    // Por qué sucede: Cada jugador debe tener sus tanques representados en el mapa.
-    std::vector<Tank> tanks;
-
-    // Añadir tanques para el jugador 1 (colores azul y rojo)
-    for (int i = 0; i < 2; ++i) {
-        int x, y;
-        do {
-            x = getRandomPosition(0, mapSize / 2 - 1);
-            y = getRandomPosition(0, mapSize - 1);
-        } while (isPositionOccupied(x, y, tanks));
-        tanks.emplace_back(Tank::BLUE, x, y, i);  // Añadir tanque azul con ID único
-    }
-    for (int i = 0; i < 2; ++i) {
-        int x, y;
-        do {
-            x = getRandomPosition(0, mapSize / 2 - 1);
-            y = getRandomPosition(0, mapSize - 1);
-        } while (isPositionOccupied(x, y, tanks));
-        tanks.emplace_back(Tank::RED, x, y, i + 2);  // Añadir tanque rojo con ID único
-    }
-
-    // Añadir tanques para el jugador 2 (colores celeste y amarillo)
-    for (int i = 0; i < 2; ++i) {
-        int x, y;
-        do {
-            x = getRandomPosition(mapSize / 2, mapSize - 1);
-            y = getRandomPosition(0, mapSize - 1);
-        } while (isPositionOccupied(x, y, tanks));
-        tanks.emplace_back(Tank::CYAN, x, y, i + 4);  // Añadir tanque celeste con ID único
-    }
-    for (int i = 0; i < 2; ++i) {
-        int x, y;
-        do {
-            x = getRandomPosition(mapSize / 2, mapSize - 1);
-            y = getRandomPosition(0, mapSize - 1);
-        } while (isPositionOccupied(x, y, tanks));
-        tanks.emplace_back(Tank::YELLOW, x, y, i + 6);  // Añadir tanque amarillo con ID único
-    }
-
-    // Inicializar variables de control para el juego
-    int currentPlayer = 1;  // Jugador actual (1 o 2)
-    Tank* selectedTank = nullptr;  // Puntero al tanque seleccionado por el jugador
-    bool waitingForBFSClick = false;  // Indica si estamos esperando un clic para el movimiento con BFS
-    bool waitingForDijkstraClick = false;  // Indica si estamos esperando un clic para el movimiento con Dijkstra
-    bool powerUsed = false;  // Indica si el jugador ya usó un poder en este turno
-    char selectedPower = '\0';  // Poder seleccionado ('M', 'D', 'P'), `\0` si no se ha seleccionado ninguno
-    std::vector<Cell> currentPath;  // Almacena la ruta calculada del tanque seleccionado
-    sf::Clock globalClock;  // Temporizador global para el tiempo total del juego
-    sf::Clock turnClock;  // Temporizador para controlar la duración de cada turno
-
-    // Variables para el modo disparo
-    bool isShootingMode = false;  // Indica si el modo disparo está activado
-    Bullet* activeBullet = nullptr;  // Puntero a la bala activa en el juego
-    bool hasShot = false;  // Indica si el tanque ya disparó en el turno actual
-
-    // Variables para el sistema de power-ups
-    PowerUp playerPowerUp[2] = { NONE, NONE };  // Power-ups asignados a cada jugador
-    bool isPowerUpActive = false;  // Indica si un power-up está activo
-    bool powerUpActivated = false;  // Indica si un power-up fue activado en el turno actual
-    bool powerUpConsumed = false;  // Indica si el power-up fue consumido
-
-    // Definir colores de tanques para cada jugador
-    std::vector<Tank::Color> player1Colors = {Tank::BLUE, Tank::RED};
-    std::vector<Tank::Color> player2Colors = {Tank::CYAN, Tank::YELLOW};
+    // Paso fijo de simulación
+    // Qué sucede: Los temporizadores del juego cuentan ticks en lugar de leer relojes reales.
+    // Por qué sucede: Así la partida dura lo mismo aunque se dibujen más o menos frames.
+    FixedTimestep timestep(config.tickSeconds, options.maxTicksPerFrame);
+    sf::Clock frameClock;  // Mide el tiempo real de cada frame
+    std::vector<GameInput> pendingInputs;  // Entradas del frame que esperan al siguiente tick
+    const std::vector<GameInput> noInputs;
+    std::vector<GameInput> replayInputs;  // Entradas del registro para el tick actual
+    FrameStats frameStats;
+    bool profileOverlay = options.profileOverlay;
+    std::vector<ProfileEvent> frameEvents;  // Mediciones del frame anterior para el resumen en pantalla
+    std::vector<ProfileTotal> frameTotals;
+
+    // Espera máxima en modo de espera: un tick menos que los que se pueden recuperar en un frame, así la espera
+    // nunca descarta tiempo de simulación
+    const sf::Time idleWait = sf::seconds(static_cast<float>((options.maxTicksPerFrame - 1) * config.tickSeconds));
 
     // Bucle principal del juego
     while (window.isOpen()) {
+        // Sin el perfilador compilado no se toca `Profiler::instance()`, que construiría el búfer circular
+        std::uint64_t frameMark = Profiler::compiledIn() ? Profiler::instance().getWriteIndex() : 0;
         sf::Event event;
-        while (window.pollEvent(event)) {
-            // Cerrar la ventana si se presiona el botón de cierre
-            if (event.type == sf::Event::Closed)
-                window.close();
-
-            // Detectar clic en un tanque para seleccionarlo
-            // Qué sucede: El jugador puede seleccionar un tanque para moverlo o atacar.
-            // Por qué sucede: Cada turno, un jugador debe poder seleccionar y mover sus tanques.
-            // Qué deberíamos esperar: El tanque seleccionado se indica visualmente y está listo para moverse.
-            if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
-                int mouseX = event.mouseButton.x / cellSize;
-                int mouseY = event.mouseButton.y / cellSize;
-
-                if (waitingForBFSClick && selectedTank != nullptr) {
-                    // Mover el tanque usando BFS si se hace clic en un destino válido
-                    if (gameMap.isValidPosition(mouseX, mouseY) && !isPositionOccupied(mouseX, mouseY, tanks)) {
-                        currentPath = bfs(gameMap, selectedTank->getX(), selectedTank->getY(), mouseX, mouseY, tanks);
-                        waitingForBFSClick = false;  // Terminar la espera para el clic
-                    }
-                } else if (waitingForDijkstraClick && selectedTank != nullptr) {
-                    // Mover el tanque usando Dijkstra si se hace clic en un destino válido
-                    if (gameMap.isValidPosition(mouseX, mouseY) && !isPositionOccupied(mouseX, mouseY, tanks)) {
-                        currentPath = dijkstra(gameMap, selectedTank->getX(), selectedTank->getY(), mouseX, mouseY, tanks);
-                        waitingForDijkstraClick = false;  // Terminar la espera para el clic
-                    }
-                } else if (selectedTank == nullptr) {
-                    // Seleccionar un tanque si no estamos esperando para BFS o Dijkstra
-                    for (Tank& tank : tanks) {
-                        if ((currentPlayer == 1 && (tank.getColor() == Tank::BLUE || tank.getColor() == Tank::RED)) ||
-                            (currentPlayer == 2 && (tank.getColor() == Tank::CYAN || tank.getColor() == Tank::YELLOW))) {
-                            if (tank.getX() == mouseX && tank.getY() == mouseY) {
-                                selectedTank = &tank;  // Selecciona el tanque
-                                std::cout << "Tanque seleccionado en (" << tank.getX() << ", " << tank.getY() << ")\n";
-                                break;
-                            }
-                        }
-                    }
-                }
-            }
 
-            // Detectar la tecla M para activar el movimiento del tanque
-            // Qué sucede: Permite al jugador mover el tanque seleccionado.
-            // Por qué sucede: Los tanques deben ser capaces de moverse en el campo de batalla.
-            if (event.type == sf::Event::KeyPressed && selectedTank != nullptr && !powerUsed) {
-                if (event.key.code == sf::Keyboard::M && selectedPower == '\0') {
-                    selectedPower = 'M';
-                    powerUsed = true;
-                    if (selectedTank->getColor() == Tank::BLUE || selectedTank->getColor() == Tank::CYAN) {
-                        int randomDecision = std::rand() % 2;
-                        if (randomDecision == 0) {
-                            std::cout << "Usando BFS para mover tanque azul/celeste\n";
-                            waitingForBFSClick = true;  // Esperar clic para definir destino
-                        } else {
-                            std::cout << "Usando movimiento aleatorio para tanque azul/celeste\n";
-                            currentPath = moveRandomly(selectedTank->getX(), selectedTank->getY(), gameMap, tanks);
-                        }
-                    } else if (selectedTank->getColor() == Tank::RED || selectedTank->getColor() == Tank::YELLOW) {
-                        int randomDecision = std::rand() % 10;
-                        if (randomDecision < 8) {
-                            std::cout << "Usando Dijkstra para mover tanque rojo/amarillo\n";
-                            waitingForDijkstraClick = true;  // Esperar clic para definir destino
-                        } else {
-                            std::cout << "Usando movimiento aleatorio para tanque rojo/amarillo\n";
-                            currentPath = moveRandomly(selectedTank->getX(), selectedTank->getY(), gameMap, tanks);
-                        }
-                    }
-                } 
+        // Modo de espera
+        // Qué sucede: Si no hay balas, ni ruta en curso, ni entradas pendientes, el bucle espera un evento en lugar
+        //             de dibujar frames idénticos.
+        // Qué deberíamos esperar: Mientras se espera un clic el proceso casi no usa CPU; el reloj sigue avanzando.
+        if (options.idleWait && replay == nullptr && pendingInputs.empty() && state.getBullets().empty() && state.getCurrentPath().empty()) {
+            sf::Clock idleClock;
+            if (waitEventFor(window, event, idleWait)) {
+                handleEvent(event, window, renderer, pendingInputs, profileOverlay);
             }
+            frameStats.recordIdle(idleClock.getElapsedTime().asSeconds());
+        }
 
-            // Detectar la tecla D para activar el modo disparo del tanque
-            // Qué sucede: Permite al tanque disparar hacia un objetivo.
-            // Por qué sucede: Los tanques necesitan atacar para eliminar a los enemigos.
-            // Qué deberíamos esperar: Activación del modo disparo y selección de un objetivo para atacar.
-            if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::D && selectedTank != nullptr && !powerUsed && !powerUpActivated) {
-                if (selectedPower == '\0') {
-                    selectedPower = 'D';
-                    powerUsed = true;
-                    isShootingMode = true;  // Activar el modo disparo
-                    std::cout << "Modo disparo activado\n";
-                }
-            }
-
-            // Detectar clic en el objetivo durante el modo disparo
-            // Qué sucede: El tanque dispara hacia la posición seleccionada.
-            // Por qué sucede: El disparo permite eliminar tanques enemigos.
-            // Qué deberíamos esperar: Creación de una bala que viaja hacia el objetivo.
-            if (isShootingMode && event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left && !hasShot) {
-                int targetX = event.mouseButton.x / cellSize;
-                int targetY = event.mouseButton.y / cellSize;
-
-                activeBullet = new Bullet(selectedTank->getX(), selectedTank->getY(), targetX, targetY, selectedTank->getId());
-
-                // Salir del modo disparo y marcar que se ha disparado en este turno
-                isShootingMode = false;
-                hasShot = true;
+        {
+            PROFILE_SCOPE("events");
+            while (window.pollEvent(event)) {
+                handleEvent(event, window, renderer, pendingInputs, profileOverlay);
             }
+        }
+        if (replay != nullptr) {
+            pendingInputs.clear();
+        }
 
-            // Detectar la tecla P para activar un power-up
-            // Qué sucede: Se activa el power-up del jugador actual si está disponible.
-            // Por qué sucede: Los power-ups permiten obtener ventajas estratégicas durante el juego.
-            if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::P && !powerUsed) {
-                if (playerPowerUp[currentPlayer - 1] != NONE && !powerUpConsumed) {
-                    isPowerUpActive = true;
-                    powerUpActivated = true;
-                    powerUpConsumed = true;
-                    std::cout << "Power-up activado: " << playerPowerUp[currentPlayer - 1] << "\n";
+        // Simular los ticks acumulados
+        // Qué sucede: Se ejecutan 0, 1 o varios ticks según el tiempo real transcurrido desde el frame anterior.
+        //             Las entradas del frame se aplican en el primer tick; si no hay tick, esperan al siguiente frame.
+        // Qué deberíamos esperar: Con frames lentos se simulan varios ticks seguidos; con frames rápidos, ninguno.
+        double frameSeconds = frameClock.restart().asSeconds();
+        frameStats.recordFrame(frameSeconds);
+        int ticks = timestep.advance(frameSeconds);
+        {
+            PROFILE_SCOPE("simulate");
+            for (int tick = 0; tick < ticks && !state.isGameOver(); ++tick) {
+                if (replay != nullptr) {
+                    replayInputs.clear();
+                    replay->inputsAt(state.getTick(), replayInputs);
+                    state.step(replayInputs);
+                } else {
+                    stepAndRecord(state, tick == 0 ? pendingInputs : noInputs, recording);
                 }
             }
         }
-
-        // Lógica para asignar power-ups aleatoriamente
-        // Qué sucede: Cada turno, hay una probabilidad del 30% de recibir un power-up.
-        // Por qué sucede: Añade un elemento de sorpresa y estrategia al juego.
-        if (!isPowerUpActive && std::rand() % 100 < 30) {
-            playerPowerUp[currentPlayer - 1] = static_cast<PowerUp>(std::rand() % 4 + 1);
+        if (ticks > 0) {
+            pendingInputs.clear();
         }
 
-        // Mostrar el power-up actual en la pantalla
-        std::string powerUpName;
-        switch (playerPowerUp[currentPlayer - 1]) {
-            case DOUBLE_TURN: powerUpName = "Doble Turno"; break;
-            case MOVE_PRECISION: powerUpName = "Precisión de Movimiento"; break;
-            case ATTACK_PRECISION: powerUpName = "Precisión de Ataque"; break;
-            case ATTACK_POWER: powerUpName = "Poder de Ataque"; break;
-            default: powerUpName = "Ninguno"; break;
-        }
-        powerUpText.setString("Power-up: " + powerUpName);
-
-        // Actualizar la bala en cada frame
-        // Qué sucede: Mueve la bala y verifica si impacta un tanque o el borde del mapa.
-        // Por qué sucede: Para simular el movimiento de la bala después de un disparo.
-        if (activeBullet != nullptr) {
-            bool destroyBullet = false;
-            activeBullet->update(gameMap, tanks, destroyBullet);
-            if (destroyBullet) {
-                delete activeBullet;
-                activeBullet = nullptr;
+        if (state.isGameOver()) {
+            printResult(state);
+            if (replay != nullptr) {
+                checkReplay(state, *replay);
             }
+            window.close();  // Cerrar el juego
+            break;
         }
 
-        // Remover tanques destruidos del vector de tanques
-        tanks.erase(std::remove_if(tanks.begin(), tanks.end(),
-            [](const Tank& tank) { return tank.isDestroyed(); }), tanks.end());
-
-        // Actualizar el texto del turno y el temporizador global
-        int remainingTime = 300 - globalClock.getElapsedTime().asSeconds();  // Tiempo restante en segundos
-        globalTimerText.setString("Tiempo: " + std::to_string(remainingTime / 60) + ":" + std::to_string(remainingTime % 60));
-        turnText.setString("Turno del Jugador: " + std::to_string(currentPlayer));
-
-        // Verificar si el tiempo se ha terminado o si un jugador ha eliminado todos los tanques del oponente
-        int player1TanksAlive = countAliveTanks(tanks, player1Colors);
-        int player2TanksAlive = countAliveTanks(tanks, player2Colors);
-
-        if (remainingTime <= 0 || player1TanksAlive == 0 || player2TanksAlive == 0) {
-            // Declarar al ganador
-            if (player1TanksAlive > player2TanksAlive) {
-                std::cout << "Jugador 1 gana con " << player1TanksAlive << " tanques vivos.\n";
-            } else if (player2TanksAlive > player1TanksAlive) {
-                std::cout << "Jugador 2 gana con " << player2TanksAlive << " tanques vivos.\n";
-            } else {
-                std::cout << "Empate, ambos jugadores tienen la misma cantidad de tanques vivos.\n";
-            }
-            window.close();  // Cerrar el juego
+        if (!options.renderEnabled) {
+            // Sin dibujo no hay `display` que aplique el límite de frames: dormir hasta el siguiente tick
+            sf::sleep(sf::seconds(static_cast<float>(config.tickSeconds)));
+            continue;
         }
 
-        // Cambiar de turno cada 15 segundos o cuando se cumplan turnos adicionales por power-up
-        if (turnClock.getElapsedTime().asSeconds() >= 15.0f || turnControl[currentPlayer - 1] > 0) {
-            if (turnControl[currentPlayer - 1] > 0) {
-                turnControl[currentPlayer - 1]--;  // Reducir turnos adicionales si existen
-            } else {
-                currentPlayer = (currentPlayer == 1) ? 2 : 1;  // Cambiar al otro jugador
+        // Fracción del siguiente tick para interpolar tanques y balas
+        {
+            PROFILE_SCOPE("draw");
+            renderer.draw(state, static_cast<float>(timestep.getAlpha()));
+            if (profileOverlay && Profiler::compiledIn()) {
+                renderer.drawProfile(frameTotals);
             }
-
-            turnClock.restart();
-            powerUsed = false;
-            selectedPower = '\0';
-            selectedTank = nullptr;
-            currentPath.clear();
-            hasShot = false;
-            powerUpActivated = false;  // Reiniciar el estado de power-up
-            powerUpConsumed = false;
-
-            // Limpiar bala activa al final del turno
-            delete activeBullet;
-            activeBullet = nullptr;
         }
 
-        // Limpiar la ventana antes de dibujar el siguiente frame
-        window.clear(sf::Color::White);
-
-        // Dibujar el mapa y los tanques
-        gameMap.draw(window, cellSize);
-        for (Tank& tank : tanks) {
-            tank.draw(window, cellSize);
+        // Mostrar el contenido dibujado en la ventana
+        {
+            PROFILE_SCOPE("display");
+            window.display();
         }
 
-        // Dibujar la ruta planificada en verde si se calculó una ruta
-        if (!currentPath.empty()) {
-            for (const Cell& cell : currentPath) {
-                sf::RectangleShape pathRect(sf::Vector2f(cellSize, cellSize));
-                pathRect.setPosition(cell.x * cellSize, cell.y * cellSize);
-                pathRect.setFillColor(sf::Color::Green);
-                window.draw(pathRect);
-            }
+        // Resumir las mediciones de este frame para mostrarlas en el siguiente
+        if (profileOverlay && Profiler::compiledIn()) {
+            frameEvents.clear();
+            Profiler::instance().collect(frameMark, frameEvents);
+            frameTotals = Profiler::summarize(frameEvents);
         }
+    }
 
-        // Mover el tanque seleccionado según la ruta calculada
-        if (!currentPath.empty() && selectedTank != nullptr) {
-            Cell nextMove = currentPath.front();
-            currentPath.erase(currentPath.begin());
-            selectedTank->setPosition(nextMove.x, nextMove.y);
+    if (options.frameStats) {
+        frameStats.report(std::cout);
+    }
+    return 0;
+}
+#endif
+
+int main(int argc, char* argv[]) {
+
+    // Opciones de la simulación
+    // Qué sucede: `--tick-rate <hz>` fija los ticks de simulación por segundo, `--max-ticks-per-frame <n>` cuántos
+    //             se pueden recuperar en un frame, `--no-render` deja de dibujar (la simulación sigue igual) y
+    //             `--headless` juega una partida entre dos jugadores automáticos sin abrir ventana y `--seed <n>` fija
+    //             la semilla de la partida (por defecto se toma de la hora). Con ventana, `--frame-limit <fps>`
+    //             (60 por defecto, 0 = sin límite) o `--vsync` fijan el ritmo de frames, `--no-idle` desactiva la
+    //             espera de eventos cuando nada se mueve y `--frame-stats` muestra el uso de CPU al salir.
+    //             Compilado con `make PROFILE=1`, `--profile` muestra el tiempo de cada sección del frame (F3 lo
+    //             alterna) y `--trace <archivo>` guarda las últimas mediciones en formato `trace_event` de Chrome.
+    //             `--map <archivo>` juega en un mapa guardado con `tankattack-mapgen` en lugar de generarlo y
+    //             `--map-strategy <noise|caves|rooms>` elige cómo se genera; `--terrain <porcentaje>` fija cuánto barro
+    //             y escombros tiene (15 por defecto, 0 = todo llano).
+    //             `--record <archivo>` guarda la semilla y las entradas de la partida; `--replay <archivo>` la
+    //             repite con ventana, o a máxima velocidad y sin dibujar con `--fast-forward` (o `--headless`).
+    // Por qué sucede: El costo de simular y el de dibujar se ajustan por separado.
+    GameConfig config;
+#ifndef TANKATTACK_HEADLESS
+    WindowOptions windowOptions;
+#endif
+    config.seed = static_cast<std::uint64_t>(std::time(nullptr));  // Semilla de la partida
+    double tickRate = 60.0;
+    int maxTicksPerFrame = 8;
+    bool renderEnabled = true;
+    int frameLimit = 60;
+    bool vsync = false;
+    bool idleWait = true;
+    bool frameStats = false;
+    bool profileOverlay = false;
+    std::string tracePath;
+    std::string recordPath;
+    std::string replayPath;
+    bool fastForward = false;
+#ifdef TANKATTACK_HEADLESS
+    bool headless = true;
+#else
+    bool headless = false;
+#endif
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--tick-rate" && i + 1 < argc) {
+            tickRate = std::atof(argv[++i]);
+        } else if (arg == "--max-ticks-per-frame" && i + 1 < argc) {
+            maxTicksPerFrame = std::atoi(argv[++i]);
+        } else if (arg == "--no-render") {
+            renderEnabled = false;
+        } else if (arg == "--frame-limit" && i + 1 < argc) {
+            frameLimit = std::atoi(argv[++i]);
+        } else if (arg == "--vsync") {
+            vsync = true;
+        } else if (arg == "--no-idle") {
+            idleWait = false;
+        } else if (arg == "--frame-stats") {
+            frameStats = true;
+        } else if (arg == "--profile") {
+            profileOverlay = true;
+        } else if (arg == "--trace" && i + 1 < argc) {
+            tracePath = argv[++i];
+        } else if (arg == "--map" && i + 1 < argc) {
+            config.mapPath = argv[++i];
+        } else if (arg == "--map-strategy" && i + 1 < argc &&
+                   MapGenerator::parseStrategy(argv[i + 1], config.mapStrategy)) {
+            ++i;
+        } else if (arg == "--terrain" && i + 1 < argc) {
+            config.terrainPercentage = std::atoi(argv[++i]);
+        } else if (arg == "--record" && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (arg == "--replay" && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (arg == "--fast-forward") {
+            fastForward = true;
+        } else if (arg == "--seed" && i + 1 < argc) {
+            config.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--headless") {
+            headless = true;
+        } else {
+            std::cerr << "Opción desconocida: " << arg << "\n";
+            return -1;
         }
+    }
+    if (!(tickRate >= 1.0 / GameState::MAX_TICK_SECONDS && tickRate <= 1.0 / GameState::MIN_TICK_SECONDS) ||
+        maxTicksPerFrame <= 0 || frameLimit < 0) {
+        std::cerr << "La frecuencia de ticks debe estar entre " << 1.0 / GameState::MAX_TICK_SECONDS << " y "
+                  << 1.0 / GameState::MIN_TICK_SECONDS << " y los ticks por frame deben ser positivos\n";
+        return -1;
+    }
+    config.tickSeconds = 1.0 / tickRate;
+
+    if ((profileOverlay || !tracePath.empty()) && !Profiler::compiledIn()) {
+        std::cerr << "El perfilador no está compilado (usar `make PROFILE=1`)\n";
+    }
 
-        // Dibujar la bala si hay una activa
-        if (activeBullet != nullptr) {
-            activeBullet->draw(window, cellSize);
+    // Repetir una partida registrada
+    // Qué sucede: La configuración y la semilla salen del registro; las opciones de simulación se ignoran.
+    InputLog replay;
+    if (!replayPath.empty()) {
+        if (!replay.load(replayPath)) {
+            std::cerr << "No se pudo leer el registro " << replayPath << "\n";
+            return -1;
         }
+        bool verbose = config.verbose;
+        config = replay.getConfig();
+        config.verbose = verbose;
+    }
 
-        // Dibujar el texto del turno, el temporizador global y el power-up actual
-        window.draw(turnText);
-        window.draw(globalTimerText);
-        window.draw(powerUpText);
+    // Mostrar la semilla para poder repetir la partida con `--seed`
+    std::cout << "Semilla: " << config.seed << "\n";
+
+    InputLog recording(config);
+    InputLog* recordingPtr = recordPath.empty() ? nullptr : &recording;
+
+    int status;
+    if (!replayPath.empty() && (headless || fastForward)) {
+        config.verbose = false;
+        status = runReplayFast(config, replay);
+    } else if (headless) {
+        config.verbose = false;
+        status = runHeadless(config, recordingPtr);
+    } else {
+#ifdef TANKATTACK_HEADLESS
+    // Opciones que solo se usan con ventana (esta versión siempre corre sin ventana)
+    (void)maxTicksPerFrame;
+    (void)renderEnabled;
+    (void)frameLimit;
+    (void)vsync;
+    (void)idleWait;
+    (void)frameStats;
+    (void)profileOverlay;
+    (void)fastForward;
+    status = 0;
+#else
+    windowOptions.maxTicksPerFrame = maxTicksPerFrame;
+    windowOptions.renderEnabled = renderEnabled;
+    windowOptions.frameLimit = static_cast<unsigned>(frameLimit);
+    windowOptions.vsync = vsync;
+    windowOptions.idleWait = idleWait;
+    windowOptions.frameStats = frameStats;
+    windowOptions.profileOverlay = profileOverlay;
+    status = runWindowed(config, windowOptions, recordingPtr, replayPath.empty() ? nullptr : &replay);
+#endif
+    }
 
-        // Mostrar el contenido dibujado en la ventana
-        window.display();
+    // Guardar el registro de entradas
+    if (recordingPtr != nullptr) {
+        if (!recording.save(recordPath)) {
+            std::cerr << "No se pudo escribir el registro " << recordPath << "\n";
+            return -1;
+        }
+        std::cout << "Registro guardado en " << recordPath << " (" << recording.getInputCount() << " entradas)\n";
     }
 
-    return 0;
+    // Guardar las mediciones del perfilador para chrome://tracing
+    if (!tracePath.empty() && Profiler::compiledIn()) {
+        std::ofstream trace(tracePath);
+        if (!trace) {
+            std::cerr << "No se pudo abrir " << tracePath << "\n";
+            return -1;
+        }
+        Profiler::instance().writeChromeTrace(trace);
+    }
+    return status;
 }
@@ -0,0 +1,141 @@
+#include "Map.h"
+#include "MapFile.h"
+#include "MapGenerator.h"
+#include "Rng.h"
+#include "ThreadPool.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+
+// Segundos transcurridos desde `start`
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Mostrar un archivo de mapa
+// Qué sucede: Lo carga, cuenta los obstáculos y compara el tiempo de carga con el de generar y procesar un mapa igual.
+static int printInfo(const std::string& path) {
+    auto start = std::chrono::steady_clock::now();
+    std::shared_ptr<const MapFile> file = MapFile::open(path);
+    if (!file) {
+        std::cerr << "No se pudo leer el mapa " << path << "\n";
+        return 1;
+    }
+    Map map(2);
+    map.load(file);
+    double loadSeconds = secondsSince(start);
+
+    int size = map.getSize();
+    std::int64_t obstacles = 0;  // Hasta 46340^2 celdas: no cabe en `int` multiplicado por 100
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            obstacles += map.isObstacle(x, y) ? 1 : 0;
+        }
+    }
+
+    start = std::chrono::steady_clock::now();
+    Map generated(size);
+    Rng rng(1);
+    generated.generateObstacles(static_cast<int>(obstacles * 100 / (static_cast<std::int64_t>(size) * size)), rng);
+    double generateSeconds = secondsSince(start);
+
+    std::cout << "Tamaño: " << size << "x" << size << "\n"
+              << "Obstáculos: " << obstacles << "\n"
+              << "Secciones: obstáculos" << (file->getNeighbors() ? ", vecinos" : "")
+              << (file->getComponents() ? ", componentes" : "") << (file->getTerrain() ? ", terreno" : "") << "\n"
+              << "Carga: " << loadSeconds * 1000.0 << " ms (generar un mapa igual: " << generateSeconds * 1000.0
+              << " ms)\n";
+    return 0;
+}
+
+// Generador de mapas (`tankattack-mapgen`)
+// Qué sucede: Genera un mapa con `MapGenerator` y lo guarda en el formato de `MapFile`, con las máscaras de vecinos,
+//             las componentes conexas ya calculadas y el terreno.
+// Opciones:
+//   --size <n>                Tamaño del mapa (20 por defecto)
+//   --obstacles <porcentaje>  Porcentaje de obstáculos (10 por defecto)
+//   --strategy <nombre>       noise, caves o rooms (noise por defecto)
+//   --threads <n>             Hilos para generar por franjas (1 por defecto)
+//   --no-connect              No unir las zonas libres (pueden quedar zonas aisladas)
+//   --terrain <porcentaje>    Barro y escombros, además de los caminos (0 por defecto = todo llano)
+//   --seed <n>                Semilla del generador
+//   --output <archivo>        Archivo de salida (obligatorio salvo con --info)
+//   --no-neighbors            No guardar las máscaras de vecinos (se calculan al cargar)
+//   --no-components           No guardar las componentes conexas
+//   --no-terrain              No guardar el terreno (al cargar todo es llano)
+//   --info <archivo>          Mostrar un mapa guardado y su tiempo de carga
+int main(int argc, char* argv[]) {
+    int size = 20;
+    int obstacles = 10;
+    std::uint64_t seed = 1;
+    std::string outputPath;
+    unsigned flags = MAP_SAVE_ALL;
+    int threads = 1;
+    GeneratorConfig generatorConfig;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--size" && hasValue) {
+            size = std::atoi(argv[++i]);
+        } else if (arg == "--obstacles" && hasValue) {
+            obstacles = std::atoi(argv[++i]);
+        } else if (arg == "--strategy" && hasValue) {
+            if (!MapGenerator::parseStrategy(argv[++i], generatorConfig.strategy)) {
+                std::cerr << "Estrategia desconocida: " << argv[i] << "\n";
+                return 1;
+            }
+        } else if (arg == "--threads" && hasValue) {
+            threads = std::atoi(argv[++i]);
+        } else if (arg == "--no-connect") {
+            generatorConfig.connect = false;
+        } else if (arg == "--terrain" && hasValue) {
+            generatorConfig.terrainPercentage = std::atoi(argv[++i]);
+        } else if (arg == "--seed" && hasValue) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--output" && hasValue) {
+            outputPath = argv[++i];
+        } else if (arg == "--no-neighbors") {
+            flags &= ~MAP_SAVE_NEIGHBORS;
+        } else if (arg == "--no-components") {
+            flags &= ~MAP_SAVE_COMPONENTS;
+        } else if (arg == "--no-terrain") {
+            flags &= ~MAP_SAVE_TERRAIN;
+        } else if (arg == "--info" && hasValue) {
+            return printInfo(argv[i + 1]);
+        } else {
+            std::cerr << "Opción desconocida o incompleta: " << arg << "\n";
+            return 1;
+        }
+    }
+    if (size < 2 || size > Map::MAX_SIZE || obstacles < 0 || obstacles > 100 || threads < 1 ||
+        generatorConfig.terrainPercentage < 0 || generatorConfig.terrainPercentage > 100 || outputPath.empty()) {
+        std::cerr << "Parámetros inválidos\n";
+        return 1;
+    }
+
+    std::unique_ptr<ThreadPool> pool;
+    if (threads > 1) {
+        pool.reset(new ThreadPool(threads));
+    }
+    generatorConfig.obstaclePercentage = obstacles;
+
+    auto start = std::chrono::steady_clock::now();
+    Map map(size);
+    MapGenerator generator(pool.get());
+    generator.generate(map, generatorConfig, seed);
+    double generateSeconds = secondsSince(start);
+    if (!map.save(outputPath, flags)) {
+        std::cerr << "No se pudo escribir " << outputPath << "\n";
+        return 1;
+    }
+    std::cout << "Mapa de " << size << "x" << size << " guardado en " << outputPath << " (generar: "
+              << generateSeconds * 1000.0 << " ms, total: " << secondsSince(start) * 1000.0 << " ms)\n";
+    if (generatorConfig.connect) {
+        std::cout << "Zonas libres antes de unirlas: " << generator.getRegionsBeforeConnect() << "\n";
+    }
+    return 0;
+}